@@ -0,0 +1,259 @@
+/*******************************************************************************
+Title:         anagram_index.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   An index from the sorted letters of a word, its signature, to
+               every word with those letters.
+Purpose:       Answers a query with one lookup per group of the user's letters
+               instead of building words one letter at a time.
+Usage:         ./findwords --engine anagram [--exact] dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+#include "anagram_index.h"
+#include "search_stats.h"
+
+// ***** Helpers *****
+
+// A word of the dictionary waiting to be indexed.
+struct SignedWord {
+  string signature; // The word's letters, sorted.
+  int position;     // Position of the word in the dictionary.
+};
+
+// Orders words by signature, then puts copies of the same word next to
+// each other, the first copy first.
+struct BySignature {
+  const vector<string>* dictionary; // The words being ordered.
+
+  bool operator()(const SignedWord& first, const SignedWord& second) const {
+    if (first.signature != second.signature)
+      return first.signature < second.signature;
+    if ((*dictionary)[first.position] != (*dictionary)[second.position])
+      return (*dictionary)[first.position] < (*dictionary)[second.position];
+    return first.position < second.position;
+  }
+};
+
+// Keeps only the letters a to z of the user's word, sorted.
+static string sortedLetters(const string& letters) {
+  string plain;
+
+  for (int i = 0; i < letters.length(); i++) {
+    if (letters[i] >= 'a' && letters[i] <= 'z')
+      plain.push_back(letters[i]);
+  }
+
+  sort(plain.begin(), plain.end());
+  return plain;
+}
+
+// Counts the letters of a signature that sorted letters don't have, walking
+// both in order the way includes does.
+static int missingLetters(const string& letters, const string& signature) {
+  int missing = 0,
+      next = 0;   // The next of the user's letters not matched yet.
+
+  for (int i = 0; i < signature.length(); i++) {
+    while (next < letters.length() && letters[next] < signature[i])
+      next++;
+
+    if (next < letters.length() && letters[next] == signature[i])
+      next++;
+    else
+      missing++;
+  }
+
+  return missing;
+}
+
+// ***** Function Definitions *****
+
+// Default constructor, an empty index.
+AnagramIndex::AnagramIndex() {
+  longestWord = 0;
+}
+
+// Indexes every word of the dictionary by its signature.
+void AnagramIndex::build(const vector<string>& dictionary) {
+  vector<SignedWord> signedWords;   // Every word that can be indexed.
+  BySignature bySignature;
+
+  signatures.clear();
+  wordPositions.clear();
+  longestWord = 0;
+
+  for (int i = 0; i < dictionary.size(); i++) {
+    if (!isPlainWord(dictionary[i]))
+      continue;
+
+    SignedWord word = {signatureOf(dictionary[i]), i};
+    signedWords.push_back(word);
+
+    if (dictionary[i].length() > longestWord)
+      longestWord = dictionary[i].length();
+  }
+
+  bySignature.dictionary = &dictionary;
+  sort(signedWords.begin(), signedWords.end(), bySignature);
+
+  // Words with the same signature are next to each other now, so each
+  // signature only needs where its words start and how many there are.
+  for (int i = 0; i < signedWords.size(); i++) {
+    const SignedWord& word = signedWords[i];
+
+    // A repeated word is only kept the first time.
+    if (i > 0 && dictionary[word.position] == dictionary[signedWords[i-1].position])
+      continue;
+
+    if (i == 0 || word.signature != signedWords[i-1].signature) {
+      SignatureRange range = {(int)wordPositions.size(), 0};
+      signatures[word.signature] = range;
+    }
+
+    signatures[word.signature].count++;
+    wordPositions.push_back(word.position);
+  }
+}
+
+// Looks up one signature and adds the words that have it.
+void AnagramIndex::lookUp(const string& signature,
+                          vector<int>& foundWordPositions) const {
+  unordered_map<string, SignatureRange>::const_iterator found =
+      signatures.find(signature);
+
+  countProbes(1, found != signatures.end());
+  if (found == signatures.end())
+    return;
+
+  for (int i = 0; i < found->second.count; i++)
+    foundWordPositions.push_back(wordPositions[found->second.first + i]);
+}
+
+// Finds the words that use exactly all of the letters, with one lookup.
+void AnagramIndex::findAnagrams(const string& letters,
+                                vector<int>& foundWordPositions) const {
+  string sorted = sortedLetters(letters);
+
+  // A character that isn't a letter can't be used, so no word uses all of
+  // them, the same as the other searches' exact filter finds.
+  if (sorted.length() != letters.length())
+    return;
+
+  lookUp(sorted, foundWordPositions);
+}
+
+// Finds all words that can be made out of some of the letters.
+void AnagramIndex::findWords(const string& letters,
+                             vector<int>& foundWordPositions) const {
+  string sorted = sortedLetters(letters),
+         signature;   // The letters chosen so far.
+  int blanks = countBlanks(letters);
+
+  if (blanks == 0 && countSubsets(sorted) <= signatures.size()) {
+    findSubsets(sorted, 0, signature, foundWordPositions);
+    return;
+  }
+
+  // A long query has more combinations than the index has signatures, and
+  // a blank multiplies them by 26, so check every signature against the
+  // letters instead. Both are sorted, so includes tells if the signature's
+  // letters are among them.
+  int matched = 0;
+  for (unordered_map<string, SignatureRange>::const_iterator i = signatures.begin();
+       i != signatures.end(); i++) {
+    if (i->first.length() < MIN_WORD_LENGTH)
+      continue;
+
+    if (blanks == 0 ? includes(sorted.begin(), sorted.end(),
+                               i->first.begin(), i->first.end())
+                    : missingLetters(sorted, i->first) <= blanks) {
+      matched++;
+      for (int j = 0; j < i->second.count; j++)
+        foundWordPositions.push_back(wordPositions[i->second.first + j]);
+    }
+  }
+
+  countProbes(signatures.size(), matched);
+}
+
+// Returns how many combinations findSubsets would try, stopping early once
+// there are more than there are signatures.
+size_t AnagramIndex::countSubsets(const string& letters) const {
+  size_t combinations = 1;
+
+  for (int group = 0; group < letters.length(); ) {
+    int end = group;
+    while (end < letters.length() && letters[end] == letters[group])
+      end++;
+
+    combinations *= end - group + 1;
+    if (combinations > signatures.size())
+      break;
+    group = end;
+  }
+
+  return combinations;
+}
+
+// Tries every count of the letters from a group onward.
+void AnagramIndex::findSubsets(const string& letters, int group, string& signature,
+                               vector<int>& foundWordPositions) const {
+  countNode(signature.length());
+
+  // No word is this long, adding more letters can't help.
+  if (signature.length() > longestWord)
+    return;
+
+  // Every group has a count, look the combination up.
+  if (group >= letters.length()) {
+    if (signature.length() >= MIN_WORD_LENGTH)
+      lookUp(signature, foundWordPositions);
+    return;
+  }
+
+  // Repeated letters are one group, so "ss" is only tried as 0, 1 or 2
+  // copies of 's' and no combination is looked up twice.
+  int end = group;
+  while (end < letters.length() && letters[end] == letters[group])
+    end++;
+
+  int chosen = signature.length();
+  for (int count = 0; count <= end - group; count++) {
+    if (count > 0)
+      signature.push_back(letters[group]);
+    findSubsets(letters, end, signature, foundWordPositions);
+  }
+
+  signature.resize(chosen);
+}
+
+// Returns the number of different signatures in the index.
+int AnagramIndex::size() const {
+  return signatures.size();
+}
+
+// Returns about how many bytes the index uses.
+size_t AnagramIndex::memoryUsed() const {
+  size_t bytes = signatures.bucket_count() * sizeof(void*) +
+                 wordPositions.capacity() * sizeof(int);
+
+  for (unordered_map<string, SignatureRange>::const_iterator it = signatures.begin();
+       it != signatures.end(); ++it) {
+    bytes += sizeof(void*) + sizeof(size_t) + sizeof(*it);
+    if (it->first.capacity() > sizeof(string) / 2)
+      bytes += it->first.capacity() + 1;
+  }
+
+  return bytes;
+}
+
+// Returns the signature of a word, its letters in alphabetical order.
+string signatureOf(const string& word) {
+  string signature = word;
+  sort(signature.begin(), signature.end());
+  return signature;
+}
@@ -0,0 +1,119 @@
+/*******************************************************************************
+Title:         anagram_index.h
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   An index from the sorted letters of a word, its signature, to
+               every word with those letters.
+Purpose:       Answers a query with one lookup per group of the user's letters
+               instead of building words one letter at a time.
+Usage:         ./findwords --engine anagram [--exact] dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+
+#ifndef ANAGRAM_INDEX_H
+#define ANAGRAM_INDEX_H
+
+#include <unordered_map>
+#include "dictionary.h"
+
+// Where the words sharing one signature are in the index's word list.
+struct SignatureRange {
+  int first,  // Position of the first word in the word list.
+      count;  // Number of words with the signature.
+};
+
+class AnagramIndex {
+private:
+  unordered_map<string, SignatureRange> signatures; // Signature to its words.
+  vector<int> wordPositions;  // Dictionary positions, grouped by signature.
+  int longestWord;            // Length of the longest word in the index.
+
+  // Looks up one signature and adds the words that have it.
+  //
+  // Precondition:  The index has been built.
+  // Postcondition: The positions of the words with signature have been added.
+  //
+  // @string& signature:                the sorted letters to look up.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void lookUp(const string& signature, vector<int>& foundWordPositions) const;
+
+  // Tries every count of the letters from a group onward, and looks up
+  // every combination that is long enough.
+  //
+  // Precondition:  letters is sorted and group is the start of a group of
+  //                the same letter.
+  // Postcondition: Every word made of signature plus some of the letters
+  //                from group onward has been found.
+  //
+  // @string& letters:                  the user's letters, sorted.
+  // @int group:                        the position of the next group of letters.
+  // @string& signature:                the letters chosen so far.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void findSubsets(const string& letters, int group, string& signature,
+                   vector<int>& foundWordPositions) const;
+
+  // Returns how many combinations findSubsets would try for letters.
+  //
+  // Precondition:  letters is sorted.
+  // Postcondition: None.
+  // return:        the count, or anything over size() once it passes size().
+  //
+  // @string& letters:                  the user's letters, sorted.
+  size_t countSubsets(const string& letters) const;
+
+public:
+  // Default constructor, an empty index.
+  AnagramIndex();
+
+  // Indexes every word of the dictionary by its signature.
+  //
+  // Precondition:  A dictionary exists, it doesn't need to be sorted.
+  // Postcondition: Every word made of the letters a to z is in the index,
+  //                repeated words only once.
+  //
+  // @vector<string>& dictionary:       a populated list of words.
+  void build(const vector<string>& dictionary);
+
+  // Finds the words that use exactly all of the letters, with one lookup.
+  //
+  // Precondition:  The index has been built.
+  // Postcondition: The positions of the anagrams of letters have been added,
+  //                none if letters has anything besides a to z.
+  //
+  // @string& letters:                  the letters of the user's word.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void findAnagrams(const string& letters, vector<int>& foundWordPositions) const;
+
+  // Finds all words that can be made out of some of the letters, with one
+  // lookup for each different group of letters. Long queries, and queries
+  // with blanks, check every signature instead.
+  //
+  // Precondition:  The index has been built.
+  // Postcondition: The positions of the words have been added, once each.
+  //
+  // @string& letters:                  the letters of the user's word.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void findWords(const string& letters, vector<int>& foundWordPositions) const;
+
+  // Returns the number of different signatures in the index.
+  int size() const;
+
+  // Returns about how many bytes the index uses, counting a pointer and a
+  // bucket for each entry of the hash table.
+  size_t memoryUsed() const;
+};
+
+
+// Returns the signature of a word, its letters in alphabetical order.
+//
+// Precondition:  None.
+// Postcondition: None.
+//
+// @string& word:                    the word to be sorted.
+string signatureOf(const string& word);
+
+#endif
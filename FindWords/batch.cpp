@@ -0,0 +1,175 @@
+/*******************************************************************************
+Title:         batch.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Finds the words for every line of a file of queries, on a
+               fixed pool of threads.
+Purpose:       Answers many queries in one run without a prompt, in the same
+               order they were given.
+Usage:         ./findwords --batch queries.txt [--threads N] dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+#include "batch.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+
+// ***** Helpers *****
+
+// What the worker threads share. The main thread fills a block of queries,
+// the workers answer them, and the main thread prints the block.
+struct BatchWork {
+  const WordFinder* finder;     // The dictionary and search.
+  const vector<string>* queries;// The queries of the current block.
+  vector<string>* answers;      // One answer for each query of the block.
+  atomic<int> nextQuery;        // The next query of the block to be taken.
+  int block;                    // Counts the blocks handed out so far.
+  int workersDone;              // Workers finished with the current block.
+  bool finished;                // No more blocks are coming.
+  mutex lock;                   // Protects block, workersDone and finished.
+  condition_variable blockReady,// Signals a new block or the end.
+                     blockDone; // Signals every worker finished the block.
+};
+
+// Answers queries of each block until there are none left.
+static void batchWorker(BatchWork* work, int workerCount) {
+  int lastBlock = 0;  // The last block this worker answered.
+
+  while (true) {
+    {
+      unique_lock<mutex> guard(work->lock);
+      while (!work->finished && work->block == lastBlock)
+        work->blockReady.wait(guard);
+
+      if (work->finished)
+        return;
+
+      lastBlock = work->block;
+    }
+
+    // Take queries one at a time, so a slow query doesn't hold up others.
+    int size = work->queries->size();
+    for (int i = work->nextQuery++; i < size; i = work->nextQuery++)
+      (*work->answers)[i] = answerQuery(*work->finder, (*work->queries)[i]);
+
+    unique_lock<mutex> guard(work->lock);
+    if (++work->workersDone == workerCount)
+      work->blockDone.notify_one();
+  }
+}
+
+// ***** Function Definitions *****
+
+// Finds the words for every query of a file and prints them in order.
+bool runBatch(const WordFinder& finder, const string& queryFile,
+              int threadCount, ostream& outputStream) {
+  ifstream inputStream(queryFile.c_str()); // The queries, one per line.
+  vector<string> queries, answers;         // The current block.
+  vector<thread> workers;                  // The fixed pool of threads.
+  BatchWork work;
+  string line;
+
+  if (!validFile(queryFile))
+    return false;
+
+  if (threadCount < 1)
+    threadCount = 1;
+
+  work.finder = &finder;
+  work.queries = &queries;
+  work.answers = &answers;
+  work.nextQuery = 0;
+  work.block = 0;
+  work.workersDone = 0;
+  work.finished = false;
+
+  for (int i = 0; i < threadCount; i++)
+    workers.push_back(thread(batchWorker, &work, threadCount));
+
+  while (inputStream) {
+    queries.clear();
+
+    // Read one block, only the first word of a line is a query.
+    while (queries.size() < BATCH_BLOCK_SIZE && getline(inputStream, line)) {
+      istringstream words(line);
+      string query;
+
+      if (words >> query)
+        queries.push_back(query);
+    }
+
+    if (queries.empty())
+      break;
+
+    answers.assign(queries.size(), "");
+
+    // Hand the block to the workers and wait for all of them.
+    {
+      unique_lock<mutex> guard(work.lock);
+      work.nextQuery = 0;
+      work.workersDone = 0;
+      work.block++;
+      work.blockReady.notify_all();
+
+      while (work.workersDone < threadCount)
+        work.blockDone.wait(guard);
+    }
+
+    for (int i = 0; i < answers.size(); i++)
+      outputStream << answers[i] << '\n';
+  }
+
+  {
+    unique_lock<mutex> guard(work.lock);
+    work.finished = true;
+    work.blockReady.notify_all();
+  }
+
+  for (int i = 0; i < workers.size(); i++)
+    workers[i].join();
+
+  outputStream.flush();
+  return true;
+}
+
+// Finds the words for one query and formats them as one line.
+string answerQuery(const WordFinder& finder, string query) {
+  vector<int> foundWordPositions; // The positions of the words found.
+  string answer;
+
+  changeToLowercase(query);
+  answer = query + ":";
+
+  if (query.length() < MIN_QUERY_LENGTH)
+    return answer + " ERROR! Your string is too short";
+  if (query.length() > finder.maxQueryLength())
+    return answer + " ERROR! Your string is too long";
+  // A pattern's ?s are the gaps of the pattern, not blanks.
+  bool blanks = !finder.matchesPatterns() && countBlanks(query) > 0;
+  if (blanks && countBlanks(query) > MAX_BLANKS)
+    return answer + " ERROR! Your string has too many blanks";
+
+  if (!finder.findWords(query, foundWordPositions))
+    return answer + " ERROR! Your pattern can only have letters, ? and *";
+
+  // Letters that came from blanks are shown in uppercase.
+  for (int i = 0; i < foundWordPositions.size(); i++) {
+    answer += ' ';
+    if (blanks)
+      answer += markBlanks(finder.word(foundWordPositions[i]), query);
+    else
+      answer += finder.word(foundWordPositions[i]);
+
+    // The best words are shown with their scores.
+    if (finder.topWords() > 0 && !finder.matchesPatterns())
+      answer += "(" + to_string(finder.score(foundWordPositions[i], query)) + ")";
+  }
+
+  return answer;
+}
@@ -0,0 +1,53 @@
+/*******************************************************************************
+Title:         batch.h
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Finds the words for every line of a file of queries, on a
+               fixed pool of threads.
+Purpose:       Answers many queries in one run without a prompt, in the same
+               order they were given.
+Usage:         ./findwords --batch queries.txt [--threads N] dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <thread>
+#include "word_finder.h"
+
+// Number of queries read and answered together before they are printed.
+const int BATCH_BLOCK_SIZE = 4096;
+
+// Finds the words for every query of a file and prints them in order, one
+// line per query: the query, a colon, and the words found.
+//
+// Precondition:  finder has loaded a dictionary.
+// Postcondition: Every query has been answered on outputStream.
+// return:        false if the query file can't be read.
+//
+// @WordFinder& finder:               the dictionary and search, shared by all threads.
+// @string& queryFile:                the name of a file with one query per line.
+// @int threadCount:                  the number of worker threads.
+// @ostream& outputStream:            where the answers are printed.
+bool runBatch(const WordFinder& finder, const string& queryFile,
+              int threadCount, ostream& outputStream);
+
+
+// Finds the words for one query and formats them as one line.
+//
+// Precondition:  finder has loaded a dictionary.
+// Postcondition: None.
+// return:        the query, a colon, and the words found separated by spaces,
+//                with the letters that came from blanks in uppercase, and
+//                each score in parentheses if only the best are wanted.
+//
+// @WordFinder& finder:               the dictionary and search.
+// @string query:                     the letters of the query.
+string answerQuery(const WordFinder& finder, string query);
+
+#endif
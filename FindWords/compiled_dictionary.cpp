@@ -0,0 +1,245 @@
+/*******************************************************************************
+Title:         compiled_dictionary.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Writes a dictionary and its trie to a binary file, and maps that
+               file back into memory read only.
+Purpose:       Skips reading and compiling the word list on every launch. All
+               processes using the same file share its pages.
+Usage:         ./findwords --compile dictionaryfile.txt dictionary.bin
+               ./findwords dictionary.bin
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+#include "compiled_dictionary.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ***** Helpers *****
+
+// Writes zeros until the file position is a multiple of 8.
+static void padTo8(ofstream& outputStream, long long& position) {
+  while (position % 8 != 0) {
+    outputStream.put('\0');
+    position++;
+  }
+}
+
+// Checks that count items of size bytes starting at start fit in a file of
+// length bytes, without the sum overflowing.
+static bool sectionFits(long long start, long long count, long long size,
+                        long long length) {
+  return start >= 0 && start <= length && count >= 0 &&
+         count <= (length - start) / size;
+}
+
+// Checks every section the header points to, and everything in them that is
+// used as a position: word offsets inside the blob, each word ended by '\0',
+// child ranges inside the node list and word positions inside the words.
+// Children always come after their parent, so a search can't loop.
+static bool validContents(const char* data, long long length) {
+  const CompiledHeader* header = (const CompiledHeader*)data;
+
+  if (memcmp(header->magic, COMPILED_MAGIC, sizeof(COMPILED_MAGIC)) != 0 ||
+      header->nodeSize != sizeof(TrieNode) ||
+      header->wordCount < 0 || header->nodeCount < 1 ||
+      header->offsetsStart % sizeof(unsigned int) != 0 ||
+      header->nodesStart % sizeof(int) != 0 ||
+      !sectionFits(header->offsetsStart, header->wordCount + 1LL,
+                   sizeof(unsigned int), length) ||
+      !sectionFits(header->blobStart, header->blobLength, 1, length) ||
+      !sectionFits(header->nodesStart, header->nodeCount, sizeof(TrieNode), length))
+    return false;
+
+  const unsigned int* offsets = (const unsigned int*)(data + header->offsetsStart);
+  const char* blob = data + header->blobStart;
+
+  if (offsets[0] != 0 || offsets[header->wordCount] > header->blobLength)
+    return false;
+
+  for (int i = 0; i < header->wordCount; i++) {
+    if (offsets[i+1] <= offsets[i] || blob[offsets[i+1] - 1] != '\0')
+      return false;
+  }
+
+  const TrieNode* nodes = (const TrieNode*)(data + header->nodesStart);
+
+  for (int i = 0; i < header->nodeCount; i++) {
+    if (nodes[i].wordPosition < -1 || nodes[i].wordPosition >= header->wordCount ||
+        nodes[i].childCount < 0)
+      return false;
+
+    if (nodes[i].childCount > 0 &&
+        (nodes[i].firstChild <= i ||
+         nodes[i].firstChild > header->nodeCount - nodes[i].childCount))
+      return false;
+  }
+
+  return true;
+}
+
+// ***** Function Definitions *****
+
+// Default constructor, no file is open.
+CompiledDictionary::CompiledDictionary() {
+  data = NULL;
+  length = 0;
+  header = NULL;
+  offsets = NULL;
+  blob = NULL;
+}
+
+// Unmaps the file if one is open.
+CompiledDictionary::~CompiledDictionary() {
+  close();
+}
+
+// Maps a compiled dictionary file read only.
+bool CompiledDictionary::open(const string& filename) {
+  struct stat status;   // Holds the size of the file.
+  int file;             // The open file.
+  void* mapping;        // Where the file was mapped.
+
+  close();
+
+  file = ::open(filename.c_str(), O_RDONLY);
+  if (file < 0) {
+    cerr << "ERROR! File: " << filename << " cannot be opened" << endl;
+    return false;
+  }
+
+  if (fstat(file, &status) != 0 || status.st_size < (off_t)sizeof(CompiledHeader)) {
+    cerr << "ERROR! File: " << filename << " is not a compiled dictionary" << endl;
+    ::close(file);
+    return false;
+  }
+
+  // The mapping stays valid after the file is closed.
+  mapping = mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, file, 0);
+  ::close(file);
+
+  if (mapping == MAP_FAILED) {
+    cerr << "ERROR! File: " << filename << " cannot be mapped" << endl;
+    return false;
+  }
+
+  data = (const char*)mapping;
+  length = status.st_size;
+  header = (const CompiledHeader*)data;
+
+  // Make sure every section, and every position in them, is inside the file
+  // before trusting it.
+  if (!validContents(data, length)) {
+    cerr << "ERROR! File: " << filename << " is not a valid compiled dictionary" << endl;
+    close();
+    return false;
+  }
+
+  offsets = (const unsigned int*)(data + header->offsetsStart);
+  blob = data + header->blobStart;
+  return true;
+}
+
+// Unmaps the file.
+void CompiledDictionary::close() {
+  if (data != NULL)
+    munmap((void*)data, length);
+
+  data = NULL;
+  length = 0;
+  header = NULL;
+  offsets = NULL;
+  blob = NULL;
+}
+
+// Returns the number of words in the dictionary.
+int CompiledDictionary::size() const {
+  return header == NULL ? 0 : header->wordCount;
+}
+
+// Returns the bytes of the mapped file.
+size_t CompiledDictionary::memoryUsed() const {
+  return data == NULL ? 0 : length;
+}
+
+// Returns the word at a position of the dictionary, ended by '\0'.
+const char* CompiledDictionary::word(int position) const {
+  return blob + offsets[position];
+}
+
+// Returns the length of the word at a position of the dictionary.
+int CompiledDictionary::wordLength(int position) const {
+  // Every word is followed by '\0', which isn't part of it.
+  return offsets[position+1] - offsets[position] - 1;
+}
+
+// Points a trie at the nodes stored in the file.
+void CompiledDictionary::attach(Trie& trie) const {
+  trie.attach((const TrieNode*)(data + header->nodesStart), header->nodeCount);
+}
+
+// Checks if a file starts like a compiled dictionary.
+bool isCompiledDictionary(const string& filename) {
+  ifstream inputStream(filename.c_str(), ios::binary);
+  char magic[sizeof(COMPILED_MAGIC)];
+
+  if (!inputStream.read(magic, sizeof(magic)))
+    return false;
+
+  return memcmp(magic, COMPILED_MAGIC, sizeof(magic)) == 0;
+}
+
+// Writes a dictionary and its trie to a compiled dictionary file.
+bool compileDictionary(const vector<string>& dictionary, const Trie& trie,
+                       const string& filename) {
+  ofstream outputStream(filename.c_str(), ios::binary | ios::trunc);
+  CompiledHeader header;
+  vector<unsigned int> offsets(dictionary.size() + 1);
+  long long position;   // How far into the file has been written.
+
+  if (!outputStream) {
+    cerr << "ERROR! File: " << filename << " cannot be written" << endl;
+    return false;
+  }
+
+  // Every word takes its length plus a '\0'.
+  offsets[0] = 0;
+  for (int i = 0; i < dictionary.size(); i++)
+    offsets[i+1] = offsets[i] + dictionary[i].length() + 1;
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, COMPILED_MAGIC, sizeof(COMPILED_MAGIC));
+  header.nodeSize = sizeof(TrieNode);
+  header.wordCount = dictionary.size();
+  header.nodeCount = trie.size();
+  header.offsetsStart = sizeof(CompiledHeader);
+  header.blobStart = header.offsetsStart + offsets.size() * sizeof(unsigned int);
+  header.blobLength = offsets.back();
+  header.nodesStart = header.blobStart + header.blobLength;
+  header.nodesStart += (8 - header.nodesStart % 8) % 8;
+
+  outputStream.write((const char*)&header, sizeof(header));
+  outputStream.write((const char*)&offsets[0], offsets.size() * sizeof(unsigned int));
+
+  for (int i = 0; i < dictionary.size(); i++)
+    outputStream.write(dictionary[i].c_str(), dictionary[i].length() + 1);
+
+  position = header.blobStart + header.blobLength;
+  padTo8(outputStream, position);
+
+  outputStream.write((const char*)trie.data(), header.nodeCount * sizeof(TrieNode));
+  outputStream.close();
+
+  if (!outputStream) {
+    cerr << "ERROR! File: " << filename << " could not be written completely" << endl;
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,132 @@
+/*******************************************************************************
+Title:         compiled_dictionary.h
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Writes a dictionary and its trie to a binary file, and maps that
+               file back into memory read only.
+Purpose:       Skips reading and compiling the word list on every launch. All
+               processes using the same file share its pages.
+Usage:         ./findwords --compile dictionaryfile.txt dictionary.bin
+               ./findwords dictionary.bin
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+
+#ifndef COMPILED_DICTIONARY_H
+#define COMPILED_DICTIONARY_H
+
+#include "dictionary.h"
+#include "trie.h"
+
+// The start of a compiled dictionary file. Every section is found by its
+// distance from the start of the file, so the file can be mapped anywhere.
+//
+// The file is laid out as:
+//   the header
+//   wordCount + 1 offsets of the words in the word blob
+//   the word blob, every word followed by '\0'
+//   nodeCount trie nodes, breadth first, the root first
+struct CompiledHeader {
+  char magic[8];          // Always COMPILED_MAGIC.
+  int nodeSize;           // sizeof(TrieNode) of the program that wrote it.
+  int wordCount;          // Number of words.
+  int nodeCount;          // Number of trie nodes.
+  int unused;             // Keeps the sections below 8 byte aligned.
+  long long offsetsStart, // Where the word offsets start.
+            blobStart,    // Where the word blob starts.
+            blobLength,   // Length of the word blob.
+            nodesStart;   // Where the trie nodes start.
+};
+
+// The first bytes of every compiled dictionary file.
+const char COMPILED_MAGIC[8] = {'F', 'W', 'D', 'I', 'C', 'T', '0', '1'};
+
+class CompiledDictionary {
+private:
+  const char* data;       // The mapped file, or NULL if none is open.
+  long long length;       // Length of the mapped file.
+  const CompiledHeader* header; // The header at the start of data.
+  const unsigned int* offsets;  // Where each word starts in the blob.
+  const char* blob;             // The words, each followed by '\0'.
+
+  // Not copyable, the mapping belongs to one object.
+  CompiledDictionary(const CompiledDictionary&);
+  CompiledDictionary& operator=(const CompiledDictionary&);
+
+public:
+  // Default constructor, no file is open.
+  CompiledDictionary();
+
+  // Unmaps the file if one is open.
+  ~CompiledDictionary();
+
+  // Maps a compiled dictionary file read only.
+  //
+  // Precondition:  filename was written by compileDictionary.
+  // Postcondition: The words and trie of the file can be used.
+  // return:        false if the file can't be mapped or isn't valid.
+  //
+  // @string& filename:                 the name of the compiled file.
+  bool open(const string& filename);
+
+  // Unmaps the file.
+  //
+  // Precondition:  None.
+  // Postcondition: No file is open.
+  void close();
+
+  // Returns the number of words in the dictionary.
+  int size() const;
+
+  // Returns the bytes of the mapped file.
+  size_t memoryUsed() const;
+
+  // Returns the word at a position of the dictionary, ended by '\0'.
+  //
+  // Precondition:  0 <= position < size().
+  //
+  // @int position:                     the position of the word.
+  const char* word(int position) const;
+
+  // Returns the length of the word at a position of the dictionary.
+  //
+  // Precondition:  0 <= position < size().
+  //
+  // @int position:                     the position of the word.
+  int wordLength(int position) const;
+
+  // Points a trie at the nodes stored in the file.
+  //
+  // Precondition:  A file is open and stays open while the trie is used.
+  // Postcondition: trie searches the mapped nodes.
+  //
+  // @Trie& trie:                       the trie to be attached.
+  void attach(Trie& trie) const;
+};
+
+
+// Checks if a file starts like a compiled dictionary.
+//
+// Precondition:  None.
+// Postcondition: None.
+//
+// @string& filename:                 the name of a file to be checked.
+bool isCompiledDictionary(const string& filename);
+
+
+// Writes a dictionary and its trie to a compiled dictionary file.
+//
+// Precondition:  trie was built from dictionary.
+// Postcondition: filename can be opened by CompiledDictionary.
+// return:        false if the file couldn't be written.
+//
+// @vector<string>& dictionary:       a populated list of words.
+// @Trie& trie:                       the trie built from dictionary.
+// @string& filename:                 the name of the file to write.
+bool compileDictionary(const vector<string>& dictionary, const Trie& trie,
+                       const string& filename);
+
+#endif
@@ -8,7 +8,11 @@ Purpose:       Demonstrates backtracking and partial solutions to
                check a combination of letters against a dictionary,
                and appends more characters if possible.
 Usage:         ./findwords dictionaryfile.txt
-Build with:    g++ -o findwords find_words.cpp dictionary.cpp
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
 Modifications: September 26: Changed binary search to sequential
                              search due to memory constraints.
 
@@ -17,8 +21,92 @@ Modifications: September 26: Changed binary search to sequential
 
                September 28: Added flexibility by using vectors
                              instead of fixed sized arrays.
+
+               October 17, 2026: Added a sorted dictionary mode that narrows
+                             a [lo, hi) range by binary search per letter.
+                             Fixed deleteLetters and findWords skipping
+                             letters after the first word was found.
+
+               October 17, 2026: findWords keeps its prefix in a buffer and
+                             its letters in a LetterPool, and inDictionary
+                             compares through a string_view, so searching
+                             makes no new strings. deleteLetters is no
+                             longer needed.
+
+               October 17, 2026: A blank in the user's word stands for any
+                             letter they don't have.
+
+               October 17, 2026: findWords asks a PrefixFilter before
+                             scanning the dictionary for a prefix.
+
+               October 17, 2026: populateDictionary splits the file into
+                             chunks and reads them on several threads. The
+                             last word no longer needs a newline after it.
+
+               October 17, 2026: The searches count what they do for
+                             --stats.
 ********************************************************************************/
 #include "dictionary.h"
+#include "prefix_filter.h"
+#include "search_stats.h"
+
+#include <thread>
+
+// ***** Helpers *****
+
+// The smallest chunk of a dictionary file worth a thread of its own.
+const size_t MIN_LOAD_CHUNK = 1 << 20;
+
+// Checks if a character separates words, the same ones >> skips.
+static inline bool isSeparator(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Breaks text[begin, end) into words at whitespace, the same as >> does,
+// and changes them to lowercase.
+static void readChunk(const string* text, size_t begin, size_t end,
+                      vector<string>* words) {
+  const char* letters = text->data();
+  size_t i = begin;
+
+  while (i < end) {
+    while (i < end && isSeparator(letters[i]))
+      i++;
+
+    size_t start = i;
+    while (i < end && !isSeparator(letters[i]))
+      i++;
+
+    if (i > start) {
+      words->emplace_back(letters + start, i - start);
+
+      string& word = words->back();
+      for (int j = 0; j < word.length(); j++) {
+        if (word[j] >= 'A' && word[j] <= 'Z')
+          word[j] += 'a' - 'A';
+      }
+    }
+  }
+}
+
+// Looks for a prefix in the dictionary unless the filter knows no word
+// starts with it, and tells the filter when it let one through for nothing.
+static bool lookUpPrefix(const vector<string>& dictionary, string_view prefix,
+                         vector<int>& foundWordPositions,
+                         const PrefixFilter* filter) {
+  if (filter != NULL && !filter->mayStartWord(prefix))
+    return false;
+
+  bool found = inDictionary(dictionary, prefix, foundWordPositions);
+
+  countProbes(1, found);
+  if (found)
+    return true;
+
+  if (filter != NULL)
+    filter->countFalsePositive(prefix);
+  return false;
+}
 
 // ***** Function Definitions *****
 
@@ -47,44 +135,88 @@ bool validFile(string filename){
 // Populates an array, dictionary, based on the contents of a provided file.
 void populateDictionary(string filename, vector<string>& dictionary){
   ifstream inputStream; // Inputstream of file containing words.
-  string word;          // A single word.
+  string text;          // The whole file.
 
-  inputStream.open((filename).c_str());
+  inputStream.open((filename).c_str(), ios::binary);
+  inputStream.seekg(0, ios::end);
+  text.resize(max((long long)inputStream.tellg(), 0LL));
+  inputStream.seekg(0, ios::beg);
+  inputStream.read(&text[0], text.size());
+  inputStream.close();
 
-  // Goes through the file and populates the dictionary if there
-  // are more possible words to be extracted.
-  do {
-    inputStream >> word;
+  // Small files aren't worth starting threads for.
+  int chunkCount = min((size_t)max(thread::hardware_concurrency(), 1u),
+                       text.size() / MIN_LOAD_CHUNK + 1);
+  vector<size_t> chunkStart(chunkCount + 1, text.size());
+  vector<vector<string> > chunkWords(chunkCount);
+  vector<thread> readers;
+
+  // Move each split forward to the end of its line, so no word is cut.
+  chunkStart[0] = 0;
+  for (int i = 1; i < chunkCount; i++) {
+    size_t newline = text.find('\n', max(text.size() / chunkCount * i,
+                                         chunkStart[i-1]));
+    chunkStart[i] = newline == string::npos ? text.size() : newline;
+  }
 
-    // If after trying to get the next string you find you're at the end of the
-    // file get out of there.
-    if (inputStream.eof()){
-      break;
-    }
+  // This thread reads the first chunk.
+  for (int i = 1; i < chunkCount; i++)
+    readers.push_back(thread(readChunk, &text, chunkStart[i], chunkStart[i+1],
+                             &chunkWords[i]));
+  readChunk(&text, chunkStart[0], chunkStart[1], &chunkWords[0]);
+
+  for (int i = 0; i < readers.size(); i++)
+    readers[i].join();
+
+  // Put the chunks together in the file's order.
+  size_t total = dictionary.size();
+  for (int i = 0; i < chunkCount; i++)
+    total += chunkWords[i].size();
+  dictionary.reserve(total);
+
+  for (int i = 0; i < chunkCount; i++) {
+    for (int j = 0; j < chunkWords[i].size(); j++)
+      dictionary.push_back(std::move(chunkWords[i][j]));
+    vector<string>().swap(chunkWords[i]);
+  }
+}
 
-    // Add that word to the dictionary.
-    dictionary.push_back(word);
+// Fills a pool with the letters of a word.
+void makeLetterPool(const string& letters, LetterPool& pool) {
+  memset(pool.counts, 0, sizeof(pool.counts));
+  pool.letterCount = 0;
+  pool.blanks = 0;
 
-  } while (!inputStream.eof());
+  for (int i = 0; i < letters.length(); i++) {
+    unsigned char letter = letters[i];
 
-  inputStream.close();
+    if (letter == BLANK) {
+      pool.blanks++;
+      continue;
+    }
+
+    // Trying a repeated letter again would only find the same words.
+    if (pool.counts[letter]++ == 0)
+      pool.letters[pool.letterCount++] = letter;
+  }
 }
 
 // Sequentially searches the dictionary for partial and full matches.
-bool inDictionary(const vector<string>& dictionary, string searchKey,
+bool inDictionary(const vector<string>& dictionary, string_view searchKey,
                       vector<int>& foundWordPositions) {
 
   int wordCount = dictionary.size();
   for (int i = 0; i < wordCount; i ++) {
+    string_view word = dictionary[i];   // Looks at the word without copying it.
 
     // If part of the word isn't even in the dictionary, there's no reason
     // to further check if the full word is in the dictionary, therefore
     // you don't have to build upon it.
-    if (searchKey == dictionary[i].substr(0,searchKey.length())) {
+    if (searchKey == word.substr(0,searchKey.length())) {
 
       // If part of the word is in the dictionary, check if it is actually
       // the full word. If it is, add it to the list of found words.
-      if (searchKey == dictionary[i])
+      if (searchKey == word)
         foundWordPositions.push_back(i);
 
       return true;
@@ -96,76 +228,182 @@ bool inDictionary(const vector<string>& dictionary, string searchKey,
 }
 
 // Finds all words that start with a given prefix.
-bool findWords(string prefix, string remainingLetters,
+bool findWords(char prefix[], int prefixLength, LetterPool& pool,
                const vector<string>& dictionary,
-               vector<int>& foundWordPositions,
-               string initialWord) {
-
-
-  // Base Case: if you've run out of remaining letters, you've found
-  //            all possible words from this word.
-  if (remainingLetters.length() <= 0) {
-    return true;
-  }
+               vector<int>& foundWordPositions, const PrefixFilter* filter) {
 
   bool wordFound = false;
 
-  // Decrease the size of remainingLetters if you can't
-  // find any word that starts with your prefix, as long as you can.
+  countNode(prefixLength);
+
+  // Try every letter left after the prefix. Finding one word does not
+  // mean the other letters can't make words too.
+  // Ex: "to" and "so" can both be built from the letters of "stop".
   //
-  // If you can find a word, add a letter of remainingLetters to
-  // your prefix until you've run out of remainingLetters.
-  while (!wordFound && remainingLetters.length() > 0){
+  // Base Case: if you've run out of letters, none of them are left to try.
+  for (int i = 0; i < pool.letterCount; i++) {
+    unsigned char letter = pool.letters[i];
+
+    if (pool.counts[letter] == 0)
+      continue;
 
     // Search the dictionary for the word:
     // (a combination of a prefix and the next remaining letter)
     //
     // if the word is not in the dictionary, move on to the next
     // remaining letter.
-    if (!inDictionary(dictionary,
-                          prefix + remainingLetters[0],
-                          foundWordPositions)) {
-
-      // cout << "I was searching for: " << prefix + remainingLetters[0] << endl;
-
-      // Move on to the next combination of base and remaining letters.
-      remainingLetters = remainingLetters.substr(1);
-
-    } else {
+    prefix[prefixLength] = letter;
+    if (lookUpPrefix(dictionary, string_view(prefix, prefixLength+1),
+                     foundWordPositions, filter)) {
 
       // This combination is in the dictionary, but there may be more words
       // that begin with the same letters as this one.
       // Ex: cry is in the dictionary, but crying may be too.
       //
-      // You pass the result of deleteLetters because remainingLetters is
-      // NOT only the letters you've never tried before, but all letters
-      // that aren't part of your prefix.
-      wordFound = findWords(prefix + remainingLetters[0],
-                            deleteLetters(initialWord, prefix + remainingLetters[0]),
-                            dictionary, foundWordPositions, initialWord);
+      // The letter is taken out of the pool while its words are found,
+      // and put back for the next letter to be tried in its place.
+      pool.counts[letter]--;
+      findWords(prefix, prefixLength+1, pool, dictionary, foundWordPositions,
+                filter);
+      pool.counts[letter]++;
+      wordFound = true;
 
-      // If this new word isn't in the dictionary, remove the last letter
-      // and move on to the next letter of the remaining letters.
-      if (!wordFound){
-        remainingLetters = remainingLetters.substr(1);
-      } // end inner if
-
-    } // end outer if
+    } // end if
+  } // end for
 
-  } // end while
+  // A blank can be any letter we've run out of. Using it for a letter we
+  // still have would only find the same words with the letters swapped.
+  for (int letter = 'a'; letter <= 'z' && pool.blanks > 0; letter++) {
+    if (pool.counts[letter] > 0)
+      continue;
+
+    prefix[prefixLength] = letter;
+    if (lookUpPrefix(dictionary, string_view(prefix, prefixLength+1),
+                     foundWordPositions, filter)) {
+      pool.blanks--;
+      findWords(prefix, prefixLength+1, pool, dictionary, foundWordPositions,
+                filter);
+      pool.blanks++;
+      wordFound = true;
+    }
+  }
 
   return wordFound;
 }
 
-// Delete the letters of lettersToDelete that are found within word.
-string deleteLetters(string word, string lettersToDelete) {
-  for (int i = 0; i < word.length(); i++) {
-    for (int j = 0; j < lettersToDelete.length(); j++) {
-      if (word[i] == lettersToDelete[j])
-        word.erase(i, 1);
+// Sorts the dictionary so that all words sharing a prefix are next to
+// each other.
+void sortDictionary(vector<string>& dictionary) {
+  sort(dictionary.begin(), dictionary.end());
+}
+
+// Orders the words of a range by their letter at a given position. Every word
+// in the range already shares the letters before that position, so only
+// the prefix itself can be too short, and it sorts first.
+struct LetterAt {
+  int position; // Position of the letter being compared.
+
+  bool operator()(const string& word, int letter) const {
+    return letterOf(word) < letter;
+  }
+
+  bool operator()(int letter, const string& word) const {
+    return letter < letterOf(word);
+  }
+
+  int letterOf(const string& word) const {
+    if (word.length() <= position)
+      return -1;
+    return (unsigned char)word[position];
+  }
+};
+
+// Narrows [lo, hi) down to the words with letter at position.
+bool letterRange(const vector<string>& dictionary, int position,
+                 unsigned char letter, int& lo, int& hi) {
+  LetterAt byLetter;                              // Compares one position.
+  vector<string>::const_iterator first = dictionary.begin() + lo,
+                                 last  = dictionary.begin() + hi;
+
+  byLetter.position = position;
+  first = lower_bound(first, last, (int)letter, byLetter);
+  last  = upper_bound(first, last, (int)letter, byLetter);
+
+  lo = first - dictionary.begin();
+  hi = last - dictionary.begin();
+  return lo < hi;
+}
+
+// Finds all words that start with a given prefix in a sorted dictionary.
+bool findWordsSorted(const vector<string>& dictionary, int lo, int hi,
+                     int depth, LetterPool& pool,
+                     vector<int>& foundWordPositions) {
+
+  bool wordFound = false;
+
+  countNode(depth);
+
+  for (int i = 0; i < pool.letterCount; i++) {
+    unsigned char letter = pool.letters[i];
+
+    if (pool.counts[letter] == 0)
+      continue;
+
+    // The child prefix can only be inside the range of its parent.
+    int childLo = lo,
+        childHi = hi;
+
+    // If no word starts with the longer prefix, don't build upon it.
+    bool found = letterRange(dictionary, depth, letter, childLo, childHi);
+
+    countProbes(1, found);
+    if (!found)
+      continue;
+
+    // The full word sorts before every longer word starting with it.
+    if (dictionary[childLo].length() == depth + 1)
+      foundWordPositions.push_back(childLo);
+
+    pool.counts[letter]--;
+    findWordsSorted(dictionary, childLo, childHi, depth + 1, pool,
+                    foundWordPositions);
+    pool.counts[letter]++;
+    wordFound = true;
+  }
+
+  if (pool.blanks == 0)
+    return wordFound;
+
+  // A blank can be any letter we've run out of, but only the letters that
+  // come next in some word of the range lead anywhere. Step through them
+  // one child range at a time, the prefix itself sorts first.
+  int next = lo;
+  while (next < hi && dictionary[next].length() == depth)
+    next++;
+
+  while (next < hi) {
+    unsigned char letter = dictionary[next][depth];
+    int childLo = next,
+        childHi = hi;
+
+    letterRange(dictionary, depth, letter, childLo, childHi);
+    countProbes(1, 1);
+
+    if (letter >= 'a' && letter <= 'z' && pool.counts[letter] == 0) {
+      if (dictionary[childLo].length() == depth + 1)
+        foundWordPositions.push_back(childLo);
+
+      pool.blanks--;
+      findWordsSorted(dictionary, childLo, childHi, depth + 1, pool,
+                      foundWordPositions);
+      pool.blanks++;
+      wordFound = true;
     }
+
+    next = childHi;
   }
-  return word;
+
+  return wordFound;
 }
 
 // Sorts a list of numbers.
@@ -196,3 +434,36 @@ void changeToLowercase(string& userWord) {
 
   userWord = string;
 }
+
+// Counts the blanks in a string of letters.
+int countBlanks(const string& letters) {
+  return count(letters.begin(), letters.end(), BLANK);
+}
+
+// Shows which letters of a found word had to come from blanks.
+string markBlanks(const string& word, const string& letters) {
+  LetterPool pool;          // The real letters not used yet.
+  string marked = word;
+
+  makeLetterPool(letters, pool);
+
+  for (int i = 0; i < marked.length(); i++) {
+    unsigned char letter = marked[i];
+
+    if (pool.counts[letter] > 0)
+      pool.counts[letter]--;
+    else
+      marked[i] = toupper(letter);
+  }
+
+  return marked;
+}
+
+// Checks if a word is only made of the letters a to z.
+bool isPlainWord(const string& word) {
+  for (int i = 0; i < word.length(); i++) {
+    if (word[i] < 'a' || word[i] > 'z')
+      return false;
+  }
+  return true;
+}
@@ -8,7 +8,11 @@ Purpose:       Demonstrates backtracking and partial solutions to
                check a combination of letters against a dictionary,
                and appends more characters if possible.
 Usage:         ./findwords dictionaryfile.txt
-Build with:    g++ -o findwords find_words.cpp dictionary.cpp
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
 Modifications: September 26: Improved Documentation
 
                September 27: Refined algorithm for finding all
@@ -16,18 +20,78 @@ Modifications: September 26: Improved Documentation
 
                September 28: Added flexibility by using vectors
                              instead of fixed sized arrays.
+
+               October 17, 2026: Added the sorted dictionary mode.
+
+               October 17, 2026: Searches keep their prefix and letters on
+                             the stack instead of in new strings.
+
+               October 17, 2026: Added MAX_RACK_LENGTH for long queries.
+
+               October 17, 2026: Added blanks.
+
+               October 17, 2026: findWords can ask a PrefixFilter before
+                             scanning for a prefix.
+
+               October 17, 2026: populateDictionary reads large files on
+                             several threads.
 ********************************************************************************/
 
 #ifndef DICTIONARY_H
 #define DICTIONARY_H
 
+#include <algorithm>
 #include <cstring>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <fstream>
 #include <vector>
 using namespace std;
 
+// The shortest word that is searched for, a single letter is never a word.
+const int MIN_WORD_LENGTH = 2;
+
+// The shortest and longest strings of letters the user can search with.
+const int MIN_QUERY_LENGTH = 2;
+const int MAX_QUERY_LENGTH = 32;
+
+// The longest string of letters searches that only follow prefixes they
+// have the letters for can take, like a sentence or a whole board.
+const int MAX_RACK_LENGTH = 1024;
+
+// A blank stands for any one letter, like a blank tile in Scrabble.
+const char BLANK = '?';
+
+// The most blanks a query can have.
+const int MAX_BLANKS = 8;
+
+// The number of values a char can have, each gets its own letter count.
+const int LETTER_VALUES = 256;
+
+// The letters a search may still add to its prefix. Using a letter is a
+// decrement and giving it back an increment, so trying one doesn't need a
+// new string.
+struct LetterPool {
+  int counts[LETTER_VALUES];            // How many of each letter are left.
+  unsigned char letters[LETTER_VALUES]; // The different letters, in the
+  int letterCount;                      // order they were given.
+  int blanks;                           // How many blanks are left.
+};
+
+// Orders positions of a dictionary by their words, so a list of positions
+// can be sorted instead of the words themselves.
+struct ByWordAt {
+  const vector<string>* dictionary; // The words being ordered.
+
+  bool operator()(int first, int second) const {
+    return (*dictionary)[first] < (*dictionary)[second];
+  }
+};
+
+// Turns away prefixes no word starts with, see prefix_filter.h.
+class PrefixFilter;
+
 // Checks if a given file is valid.
 //
 // Precondition:  None.
@@ -38,15 +102,29 @@ bool validFile(string filename);
 
 
 // Populates an array, dictionary, based on the contents of a provided file.
+// The file is read at once and split into chunks at newlines, each chunk
+// is broken into lowercase words on its own thread, and the chunks' words
+// are put together in the file's order.
 //
 // Precondition:  The accompanying file is valid.
-// Postcondition: A dictionary has been created.
+// Postcondition: A dictionary has been created, in the order of the file.
 //
 // @string filename:                  the name of a file containing a list of words.
 // @vector<string>& dictionary:       an empty list to be filled with the words found in filename.
 void populateDictionary(string filename, vector<string>& dictionary);
 
 
+// Fills a pool with the letters of a word.
+//
+// Precondition:  None.
+// Postcondition: pool holds one count per copy of each letter of letters,
+//                and the number of blanks.
+//
+// @string& letters:                  the letters of the user's word.
+// @LetterPool& pool:                 the pool to be filled.
+void makeLetterPool(const string& letters, LetterPool& pool);
+
+
 // Sequentially searches the dictionary for partial and full matches.
 //
 // Precondition:  A dictionary exists.
@@ -54,38 +132,78 @@ void populateDictionary(string filename, vector<string>& dictionary);
 //                in the dictionary.
 //
 // @vector<string>& dictionary:       a populated list of words.
-// @string searchKey:                 a string of letters to be searched.
+// @string_view searchKey:            a string of letters to be searched.
 // @vector<int>& foundWordPositions:  a list of the positions where words were found.
-bool inDictionary(const vector<string>& dictionary, string searchKey,
+bool inDictionary(const vector<string>& dictionary, string_view searchKey,
                       vector<int>& foundWordPositions);
 
 
-// Finds all words that start with a given prefix.
+// Finds all words that start with a given prefix. A blank is only used
+// for a letter the pool has run out of. A prefix the filter turns away
+// isn't looked for in the dictionary.
 //
-// Precondition:  A dictionary has already been created.
-// Postcondition: All possible words starting with a given prefix have been found.
+// Precondition:  A dictionary has already been created, and prefix has room
+//                for prefixLength plus every letter left in pool.
+// Postcondition: All possible words starting with a given prefix have been
+//                found, and pool holds the same letters as before.
 //
-// @string prefix:                    the beginning portion of the string you're looking for.
-// @string remainingLetters:          a string of characters that can be appended
-//                                    to the prefix.
+// @char prefix[]:                    the beginning portion of the string you're looking for.
+// @int prefixLength:                 the number of letters in prefix.
+// @LetterPool& pool:                 the letters that can be appended to the prefix.
 // @vector<string>& dictionary:       a populated list of words.
 // @vector<int>& foundWordPositions:  a list of the positions where words were found.
-// @string originalWord:              the original word that the user had input.
-bool findWords(string prefix, string remainingLetters,
+// @PrefixFilter* filter:             the prefixes words may start with, or NULL.
+bool findWords(char prefix[], int prefixLength, LetterPool& pool,
                const vector<string>& dictionary,
-               vector<int>& foundWordPositions,
-               string originalWord);
+               vector<int>& foundWordPositions, const PrefixFilter* filter);
 
 
-// Delete the letters of lettersToDelete that are found within word.
+// Sorts the dictionary so that all words sharing a prefix are next to
+// each other.
 //
-// Precondition:  None.
-// Postcondition: None.
-// return:        a string of characters missing the letters of lettersToDelete.
+// Precondition:  A dictionary exists.
+// Postcondition: The dictionary is in lexicographical order.
 //
-// @string word:                     a given string of characters.
-// @string lettersToDelete:          a string of letters to be deleted from word.
-string deleteLetters(string word, string lettersToDelete);
+// @vector<string>& dictionary:       a populated list of words.
+void sortDictionary(vector<string>& dictionary);
+
+
+// Narrows a range of a sorted dictionary down to the words with a given
+// letter at a given position.
+//
+// Precondition:  [lo, hi) holds every word starting with some prefix that
+//                is position letters long (the whole dictionary for 0).
+// Postcondition: [lo, hi) holds every word starting with that prefix
+//                followed by letter.
+// return:        false if no word starts with the longer prefix.
+//
+// @vector<string>& dictionary:       a sorted list of words.
+// @int position:                     the position of the letter in the words.
+// @unsigned char letter:             the letter the words must have there.
+// @int& lo:                          the first position of the range.
+// @int& hi:                          one past the last position of the range.
+bool letterRange(const vector<string>& dictionary, int position,
+                 unsigned char letter, int& lo, int& hi);
+
+
+// Finds all words that start with a given prefix in a sorted dictionary.
+// The range stands in for the prefix, every word in it starts with it.
+// A blank is only tried for the letters the words in the range have next.
+//
+// Precondition:  The dictionary is sorted and [lo, hi) holds every word
+//                starting with a prefix that is depth letters long.
+// Postcondition: All possible words starting with the prefix have been
+//                found, and pool holds the same letters as before.
+//
+// @vector<string>& dictionary:       a sorted list of words.
+// @int lo:                           the first position of the prefix's range.
+// @int hi:                           one past the last position of the prefix's range.
+// @int depth:                        the number of letters in the prefix.
+// @LetterPool& pool:                 the letters that can be appended to the prefix.
+// @vector<int>& foundWordPositions:  a list of the positions where words were found.
+bool findWordsSorted(const vector<string>& dictionary, int lo, int hi,
+                     int depth, LetterPool& pool,
+                     vector<int>& foundWordPositions);
 
 
 // Sorts a list of numbers.
@@ -114,4 +232,35 @@ void deleteDuplicates(vector<int>& foundWordPositions);
 // @string& userWord:                a string to be converted to lowercase.
 void changeToLowercase(string& userWord);
 
+
+// Counts the blanks in a string of letters.
+//
+// Precondition:  None.
+// Postcondition: None.
+//
+// @string& letters:                 the letters of the user's word.
+int countBlanks(const string& letters);
+
+
+// Shows which letters of a found word had to come from blanks, by making
+// them uppercase. Real letters are used first, from left to right, the
+// same way the searches use them.
+//
+// Precondition:  word can be made out of letters.
+// Postcondition: None.
+// return:        the word with the letters made from blanks in uppercase.
+//
+// @string& word:                    a word that was found.
+// @string& letters:                 the letters of the user's word.
+string markBlanks(const string& word, const string& letters);
+
+
+// Checks if a word is only made of the letters a to z.
+//
+// Precondition:  None.
+// Postcondition: None.
+//
+// @string& word:                    the word to be checked.
+bool isPlainWord(const string& word);
+
 #endif
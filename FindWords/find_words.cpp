@@ -7,45 +7,245 @@ Description:   Finds all words in a dictionary that can be made
 Purpose:       Demonstrates backtracking and partial solutions to
                check a combination of letters against a dictionary,
                and appends more characters if possible.
-Usage:         ./findwords dictionaryfile.txt
-Build with:    g++ -o findwords find_words.cpp dictionary.cpp
+Usage:         ./findwords [--engine legacy|sorted|trie|anagram|histogram|
+                                     louds]
+                           [--exact] [--parallel N] [--cache MB]
+                           [--patterns] [--top K [--scores file]]
+                           [--stats] dictionaryfile.txt
+               ./findwords --batch queries.txt [--threads N] dictionaryfile.txt
+               ./findwords --server socketpath [--threads N] dictionaryfile.txt
+               ./findwords --compile dictionaryfile.txt dictionary.bin
+               ./findwords dictionary.bin
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
 Modifications: September 27: Implemented sortWords and deleteDuplicates.
                              Improved error handling.
 
                September 28: Added flexibility by using vectors
                              instead of fixed sized arrays.
+
+               October 17, 2026: Added --engine to pick the sorted
+                             dictionary search or the compiled trie.
+                             Added --compile and memory mapped dictionaries.
+                             Moved the searches into WordFinder. Added the
+                             anagram index and --exact. Added the letter
+                             histogram filter. Added --batch,
+                             --parallel, --cache and --server. Queries
+                             may be up to MAX_RACK_LENGTH letters for
+                             every search but legacy. A ? in the user's
+                             word is a blank. Added --patterns, --top
+                             and --scores. Added the louds search, and
+                             the memory the dictionary takes is shown
+                             once it is loaded. The legacy search's prefix
+                             filter statistics are shown on exit. Added
+                             --stats.
 ********************************************************************************/
 
-#include "dictionary.h"
+#include "word_finder.h"
+#include "batch.h"
+#include "server.h"
+
+// Prints how well the cache did to the error stream, so it doesn't mix
+// with the words found.
+void printCacheStatistics(const ResultCache& cache) {
+  cerr << "Cache: " << cache.hitCount() << " hits, "
+       << cache.missCount() << " misses, "
+       << cache.size() << " answers in "
+       << cache.memoryUsed() / 1024 << " KB" << endl;
+}
+
+// Prints how many prefixes the legacy search's filter turned away, on the
+// error stream too.
+void printPrefixStatistics(const PrefixFilter& filter) {
+  cerr << "Prefix filter: " << filter.probeCount() << " prefixes checked, "
+       << filter.rejectionCount() << " turned away ("
+       << 100 * filter.rejectionRatio() << "%), "
+       << filter.falsePositiveCount() << " let through that start no word ("
+       << 100 * filter.falsePositiveRate() << "% of those), "
+       << filter.memoryUsed() / 1024 << " KB" << endl;
+}
 
 int main(int argc, char *argv[]) {
 
-  vector<string> dictionary; // Store the words making up our dictionary.
-  bool otherWords;           // Store the value of the call of findWords.
+  WordFinder finder;         // Store the dictionary and search for words.
+  SearchEngine engine;       // Store the search the user picked.
+  bool exact = false,        // Store whether only full anagrams are wanted.
+       patterns = false,     // Store whether queries are patterns.
+       stats = false;        // Store whether each search is counted.
+  int threadCount = thread::hardware_concurrency(), // Store the batch threads.
+      searchThreads = 1,     // Store the threads sharing one search.
+      cacheMegabytes = 0,    // Store the memory for remembered answers.
+      topCount = 0;          // Store how many of the best words are wanted.
   string userWord,           // Store the user's word.
-         userAnswer;         // Store the user's answer.
+         userAnswer,         // Store the user's answer.
+         engineName,         // Store the name of the search the user picked.
+         filename,           // Store the dictionary file's name.
+         compileTo,          // Store where to write a compiled dictionary.
+         batchFile,          // Store the file of queries to answer.
+         socketPath,         // Store where to listen for queries.
+         scoresFile;         // Store where the letters' points are.
+
+  // Read the options, anything that isn't an option is the dictionary file.
+  for (int i = 1; i < argc; i++) {
+    string argument = argv[i];
+
+    if (argument == "--engine" && i+1 < argc) {
+      engineName = argv[++i];
+    } else if (argument == "--exact") {
+      exact = true;
+    } else if (argument == "--patterns") {
+      patterns = true;
+    } else if (argument == "--stats") {
+      stats = true;
+    } else if (argument == "--top" && i+1 < argc) {
+      topCount = atoi(argv[++i]);
+    } else if (argument == "--scores" && i+1 < argc) {
+      scoresFile = argv[++i];
+    } else if (argument == "--batch" && i+1 < argc) {
+      batchFile = argv[++i];
+    } else if (argument == "--server" && i+1 < argc) {
+      socketPath = argv[++i];
+    } else if (argument == "--threads" && i+1 < argc) {
+      threadCount = atoi(argv[++i]);
+    } else if (argument == "--parallel" && i+1 < argc) {
+      searchThreads = atoi(argv[++i]);
+    } else if (argument == "--cache" && i+1 < argc) {
+      cacheMegabytes = atoi(argv[++i]);
+    } else if (argument == "--compile" && i+2 < argc) {
+      filename = argv[++i];
+      compileTo = argv[++i];
+    } else {
+      filename = argument;
+    }
+  }
+
+  if (filename.empty()) {
+    cerr << "Usage: " << argv[0] << " [--engine legacy|sorted|trie|anagram|histogram|louds] [--exact] [--parallel N] [--cache MB] [--patterns] [--top K [--scores file]] [--stats] dictionaryfile.txt" << endl;
+    cerr << "       " << argv[0] << " --batch queries.txt [--threads N] dictionaryfile.txt" << endl;
+    cerr << "       " << argv[0] << " --server socketpath [--threads N] dictionaryfile.txt" << endl;
+    cerr << "       " << argv[0] << " --compile dictionaryfile.txt dictionary.bin" << endl;
+    exit(0);
+  }
 
   // Check if the file the user provided on the command line
   // is a valid file to check.
-  if (validFile(argv[1]))
-    populateDictionary(argv[1], dictionary);
-  else
+  if (!validFile(filename))
+    exit(0);
+
+  // Compile the dictionary and its trie once, so later runs can map them.
+  if (!compileTo.empty()) {
+    vector<string> dictionary; // Store the words making up our dictionary.
+    Trie trie;                 // Store the compiled dictionary.
+
+    populateDictionary(filename, dictionary);
+    trie.build(dictionary);
+
+    if (!compileDictionary(dictionary, trie, compileTo))
+      exit(0);
+
+    cout << "Compiled " << dictionary.size() << " words into " << compileTo << endl;
+    return 0;
+  }
+
+  // A compiled dictionary is searched as a trie unless told otherwise.
+  if (engineName.empty())
+    engineName = isCompiledDictionary(filename) ? "trie" : "legacy";
+
+  if (!engineFromName(engineName, engine)) {
+    cerr << "ERROR! Unknown engine: " << engineName << endl;
+    exit(0);
+  }
+
+  if (!finder.load(filename, engine))
     exit(0);
 
+  // Tell how much memory the dictionary takes, on the error stream so it
+  // doesn't mix with the words found.
+  cerr << "Loaded " << finder.size() << " words in "
+       << finder.memoryUsed() / 1024 << " KB" << endl;
+
+  if (patterns && !finder.usePatterns())
+    exit(0);
+
+  // Only the best words are wanted, scored like Scrabble unless a file
+  // says otherwise.
+  if (topCount > 0) {
+    ScoreTable scores;
+    defaultScores(scores);
+
+    if (!scoresFile.empty() && !loadScores(scoresFile, scores))
+      exit(0);
+
+    finder.setTopWords(topCount, scores);
+  }
+
+  finder.setExactOnly(exact);
+  finder.setSearchThreads(searchThreads);
+
+  // Repeated sets of letters are answered from memory.
+  ResultCache cache((size_t)cacheMegabytes * 1024 * 1024);
+  if (cacheMegabytes > 0)
+    finder.setCache(&cache);
+
+  // What each search does is shown on the error stream, next to the cache's
+  // and filter's statistics.
+  SearchLog statsLog(cerr);
+  if (stats)
+    finder.setStatsLog(&statsLog);
+
+  // Answer a whole file of queries without asking anything.
+  if (!batchFile.empty()) {
+    if (!runBatch(finder, batchFile, threadCount, cout))
+      exit(0);
+
+    if (cacheMegabytes > 0)
+      printCacheStatistics(cache);
+    if (engine == LEGACY_ENGINE)
+      printPrefixStatistics(finder.prefixFilter());
+    if (stats)
+      statsLog.printSummary();
+    return 0;
+  }
+
+  // Keep the dictionary loaded and answer clients until interrupted.
+  if (!socketPath.empty()) {
+    if (!runServer(finder, socketPath, threadCount))
+      exit(0);
+
+    if (cacheMegabytes > 0)
+      printCacheStatistics(cache);
+    if (engine == LEGACY_ENGINE)
+      printPrefixStatistics(finder.prefixFilter());
+    if (stats)
+      statsLog.printSummary();
+    return 0;
+  }
+
   do {
 
-    cout << "Enter a string of characters without spaces: ";
+    if (patterns)
+      cout << "Enter a pattern like c?t* and optionally /letters: ";
+    else
+      cout << "Enter a string of characters without spaces, ? for a blank: ";
     cin >> userWord;
 
     // If the user's word is invalid, prompt them to enter it again until
     // they get it right.
-    while (userWord.length() < 2 || userWord.length() > 32){
-      if (userWord.length() < 2) {
+    while (userWord.length() < MIN_QUERY_LENGTH ||
+           userWord.length() > finder.maxQueryLength() ||
+           (!patterns && countBlanks(userWord) > MAX_BLANKS)){
+      if (userWord.length() < MIN_QUERY_LENGTH) {
         cout << "Your string is too short, please try again: ";
         cin >> userWord;
-      } else if (userWord.length() > 32) {
+      } else if (userWord.length() > finder.maxQueryLength()) {
         cout << "Your string is too long, please try again: ";
         cin >> userWord;
+      } else {
+        cout << "Your string has too many blanks, please try again: ";
+        cin >> userWord;
       }
     }
 
@@ -58,29 +258,25 @@ int main(int argc, char *argv[]) {
     changeToLowercase(userWord);
     cout << "Your word was: " << userWord << endl;
 
-    // Search for possible words:
-    // 1. Use 1 letter of the user's word as the prefix
-    // 2. Obtain all letters of the user's word that are not the prefix
-    // 3. Loop through until you've tried every possible letter as a prefix
-    for (int i = 0; i < userWord.length(); i++) {
-      otherWords = findWords(userWord.substr(i, 1),
-                             userWord.substr(0, i) + userWord.substr(i+1),
-                             dictionary,
-                             foundWordPositions, userWord);
-    }
-
-    // Sort the words in our list of found words, and then delete duplicates
-    sortWords(foundWordPositions);
-    deleteDuplicates(foundWordPositions);
-
-    if (foundWordPositions.size() == 0) {
+    if (!finder.findWords(userWord, foundWordPositions)) {
+      cout << "ERROR! Your pattern can only have letters, ? and *" << endl;
+    } else if (foundWordPositions.size() == 0) {
       cout << "No words were found" << endl;
     } else {
       cout << "The found words were:" << endl;
 
-      // Print all of the found words
+      // Print all of the found words, with the letters that came from
+      // blanks in uppercase.
       for (int i = 0; i < foundWordPositions.size(); i++){
-        cout << dictionary[foundWordPositions[i]] << endl;
+        if (!patterns && countBlanks(userWord) > 0)
+          cout << markBlanks(finder.word(foundWordPositions[i]), userWord);
+        else
+          cout << finder.word(foundWordPositions[i]);
+
+        // The best words are shown with their scores.
+        if (topCount > 0 && !patterns)
+          cout << " " << finder.score(foundWordPositions[i], userWord);
+        cout << endl;
       }
     }
 
@@ -93,5 +289,12 @@ int main(int argc, char *argv[]) {
     changeToLowercase(userAnswer);
   } while (userAnswer != "quit");
 
+  if (cacheMegabytes > 0)
+    printCacheStatistics(cache);
+  if (engine == LEGACY_ENGINE)
+    printPrefixStatistics(finder.prefixFilter());
+  if (stats)
+    statsLog.printSummary();
+
   return 0;
 }
@@ -0,0 +1,354 @@
+/*******************************************************************************
+Title:         findwords_bench.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Times every search on made up dictionaries and queries, and
+               reports throughput, latency percentiles, heap allocations
+               per query and the peak memory each search adds. Exits with
+               1 if the searches that answered every query found different
+               numbers of words.
+Purpose:       Shows whether a change to a search makes it faster or slower.
+               The same seed makes the same dictionaries and queries, so runs
+               from different days can be compared.
+Usage:         ./findwords_bench [--seed N] [--sizes 10000,100000]
+                                 [--engines legacy,sorted,trie,anagram,
+                                            histogram,louds]
+                                 [--queries N] [--lengths 2-12] [--budget S]
+Build with:    g++ -O2 -o findwords_bench findwords_bench.cpp dictionary.cpp
+               trie.cpp compiled_dictionary.cpp anagram_index.cpp
+               word_finder.cpp histogram_filter.cpp pattern_index.cpp
+               word_score.cpp louds_trie.cpp prefix_filter.cpp search_stats.cpp
+               result_cache.cpp -pthread
+********************************************************************************/
+#include "word_finder.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+#include <fstream>
+#include <malloc.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// The letters words and queries are made of, repeated about as often as
+// they are in English so the searches meet realistic prefixes.
+const string LETTERS = "eeeeeeeeeeeetttttttttaaaaaaaaoooooooiiiiiiinnnnnnn"
+                       "sssssshhhhhhrrrrrrddddllllcccuuummmwwffggyyppbbvkjxqz";
+
+// Every heap allocation the process makes, counted by operator new below.
+static atomic<long long> allocationCount(0);
+
+// Counts an allocation and makes it like the default operator new does.
+// The array and sized forms below go through these two, so every new is
+// counted once and every delete matches the new that made it.
+void* operator new(size_t size) {
+  allocationCount++;
+
+  void* memory = malloc(size == 0 ? 1 : size);
+  if (memory == NULL)
+    throw bad_alloc();
+  return memory;
+}
+
+void operator delete(void* memory) noexcept {
+  free(memory);
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete[](void* memory) noexcept {
+  operator delete(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+  operator delete(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+  operator delete(memory);
+}
+
+// What one run of the benchmark is set to.
+struct BenchSettings {
+  unsigned int seed;        // Seeds every random choice.
+  vector<int> sizes;        // Numbers of words in each dictionary.
+  vector<string> engines;   // Names of the searches to time.
+  int queryCount;           // Queries per dictionary.
+  int minLength,            // Shortest query.
+      maxLength;            // Longest query.
+  double budget;            // Seconds each search may spend on its queries.
+};
+
+// What a search found, sent back from its process so the searches can be
+// checked against each other.
+struct BenchCounts {
+  long long queriesRun;     // Queries answered before the budget ran out.
+  long long wordsFound;     // Words found for all of them.
+};
+
+// Makes a sorted dictionary of different words, 2 to 15 letters long. The
+// legacy search only checks the first word starting with a prefix, so it
+// needs a sorted dictionary like the word lists it was written for.
+vector<string> makeDictionary(int size, mt19937& random) {
+  uniform_int_distribution<int> letter(0, LETTERS.length() - 1),
+                                length(2, 15);
+  unordered_set<string> seen;
+  vector<string> dictionary;
+
+  while ((int)dictionary.size() < size) {
+    string word;
+    int wordLength = length(random);
+
+    for (int i = 0; i < wordLength; i++)
+      word += LETTERS[letter(random)];
+
+    if (seen.insert(word).second)
+      dictionary.push_back(word);
+  }
+
+  sort(dictionary.begin(), dictionary.end());
+  return dictionary;
+}
+
+// Makes queries with lengths spread evenly between the settings' limits.
+vector<string> makeQueries(const BenchSettings& settings, mt19937& random) {
+  uniform_int_distribution<int> letter(0, LETTERS.length() - 1),
+                                length(settings.minLength, settings.maxLength);
+  vector<string> queries;
+
+  for (int i = 0; i < settings.queryCount; i++) {
+    string query;
+    int queryLength = length(random);
+
+    for (int j = 0; j < queryLength; j++)
+      query += LETTERS[letter(random)];
+
+    queries.push_back(query);
+  }
+
+  return queries;
+}
+
+// Returns the latency at a fraction of the sorted latencies.
+double percentile(const vector<double>& sortedLatencies, double fraction) {
+  if (sortedLatencies.empty())
+    return 0;
+
+  int position = fraction * (sortedLatencies.size() - 1) + 0.5;
+  return sortedLatencies[position];
+}
+
+// Returns a field of /proc/self/status in KB, 0 if it can't be read.
+long long statusKB(const string& field) {
+  ifstream status("/proc/self/status");
+  string line;
+
+  while (getline(status, line))
+    if (line.compare(0, field.length() + 1, field + ":") == 0)
+      return atoll(line.c_str() + field.length() + 1);
+
+  return 0;
+}
+
+// Times one search on one dictionary and prints a line of results. Runs
+// in its own forked process. A fork starts with the parent's peak memory,
+// which counts the dictionaries and queries, so the peak is reset and only
+// what it grows past the memory at the start is shown. Returns what the
+// search found.
+BenchCounts benchEngine(const BenchSettings& settings, const string& engineName,
+                        const vector<string>& dictionary,
+                        const vector<string>& queries) {
+  typedef chrono::steady_clock Clock;
+  WordFinder finder;
+  SearchEngine engine;
+  vector<double> latencies;     // Microseconds for each query.
+  vector<int> foundWordPositions;
+  long long wordsFound = 0,
+            allocations = 0,    // Made while searching, not while timing.
+            startKB;            // Resident memory before the search.
+  BenchCounts counts = {0, 0};
+
+  if (!engineFromName(engineName, engine)) {
+    cerr << "ERROR! Unknown engine: " << engineName << endl;
+    return counts;
+  }
+
+  // Memory the parent freed would be reused without showing, so it is given
+  // back first. Writing 5 to clear_refs resets the peak to the memory in use.
+  malloc_trim(0);
+  ofstream("/proc/self/clear_refs") << "5";
+  startKB = statusKB("VmRSS");
+
+  Clock::time_point start = Clock::now();
+  finder.useWords(dictionary, engine);
+  double buildSeconds = chrono::duration<double>(Clock::now() - start).count();
+
+  // Stop early on searches that can't finish in time, like the legacy
+  // search on long queries.
+  Clock::time_point queriesStart = Clock::now();
+  double elapsed = 0;
+
+  for (size_t i = 0; i < queries.size() && elapsed < settings.budget; i++) {
+    long long allocationsBefore = allocationCount;
+    Clock::time_point before = Clock::now();
+    finder.findWords(queries[i], foundWordPositions);
+    Clock::time_point after = Clock::now();
+    allocations += allocationCount - allocationsBefore;
+
+    latencies.push_back(chrono::duration<double, micro>(after - before).count());
+    wordsFound += foundWordPositions.size();
+    elapsed = chrono::duration<double>(after - queriesStart).count();
+  }
+
+  sort(latencies.begin(), latencies.end());
+  long long peakKB = max(statusKB("VmHWM") - startKB, 0LL);
+
+  cout << engineName << '\t' << dictionary.size() << '\t'
+       << latencies.size() << '/' << queries.size() << '\t'
+       << buildSeconds * 1000 << '\t'
+       << (elapsed > 0 ? latencies.size() / elapsed : 0) << '\t'
+       << percentile(latencies, 0.50) << '\t'
+       << percentile(latencies, 0.99) << '\t'
+       << percentile(latencies, 0.999) << '\t'
+       << (latencies.empty() ? 0 : (double)allocations / latencies.size()) << '\t'
+       << peakKB / 1024.0 << '\t'
+       << wordsFound << endl;
+
+  counts.queriesRun = latencies.size();
+  counts.wordsFound = wordsFound;
+  return counts;
+}
+
+// Splits a comma separated list.
+vector<string> splitList(const string& list) {
+  vector<string> items;
+  istringstream stream(list);
+  string item;
+
+  while (getline(stream, item, ','))
+    if (!item.empty())
+      items.push_back(item);
+
+  return items;
+}
+
+int main(int argc, char *argv[]) {
+  BenchSettings settings;
+  bool seeded = false,
+       agreed = true;         // Every search found as many words.
+
+  settings.seed = 0;
+  settings.sizes.push_back(10000);
+  settings.sizes.push_back(100000);
+  settings.engines = splitList("legacy,sorted,trie,anagram,histogram,louds");
+  settings.queryCount = 1000;
+  settings.minLength = 2;
+  settings.maxLength = 12;
+  settings.budget = 10;
+
+  for (int i = 1; i < argc; i++) {
+    string argument = argv[i];
+
+    if (argument == "--seed" && i+1 < argc) {
+      settings.seed = strtoul(argv[++i], NULL, 10);
+      seeded = true;
+    } else if (argument == "--sizes" && i+1 < argc) {
+      vector<string> sizes = splitList(argv[++i]);
+      settings.sizes.clear();
+      for (size_t j = 0; j < sizes.size(); j++)
+        settings.sizes.push_back(atoi(sizes[j].c_str()));
+    } else if (argument == "--engines" && i+1 < argc) {
+      settings.engines = splitList(argv[++i]);
+    } else if (argument == "--queries" && i+1 < argc) {
+      settings.queryCount = atoi(argv[++i]);
+    } else if (argument == "--lengths" && i+1 < argc) {
+      if (sscanf(argv[++i], "%d-%d", &settings.minLength, &settings.maxLength) != 2) {
+        cerr << "ERROR! Lengths look like 2-12" << endl;
+        return 1;
+      }
+    } else if (argument == "--budget" && i+1 < argc) {
+      settings.budget = atof(argv[++i]);
+    } else {
+      cerr << "Usage: " << argv[0] << " [--seed N] [--sizes 10000,100000]"
+           << " [--engines legacy,sorted,trie,anagram,histogram,louds] [--queries N]"
+           << " [--lengths 2-12] [--budget S]" << endl;
+      return 1;
+    }
+  }
+
+  for (size_t i = 0; i < settings.engines.size(); i++) {
+    SearchEngine engine;
+    if (!engineFromName(settings.engines[i], engine)) {
+      cerr << "ERROR! Unknown engine: " << settings.engines[i] << endl;
+      return 1;
+    }
+  }
+
+  // Without a seed every run is different, print it so a run can be repeated.
+  if (!seeded)
+    settings.seed = random_device()();
+
+  cout << "seed " << settings.seed << ", " << settings.queryCount
+       << " queries of " << settings.minLength << "-" << settings.maxLength
+       << " letters" << endl;
+  cout << "engine\twords\tqueries\tbuild_ms\tqueries_per_s\tp50_us\tp99_us"
+       << "\tp999_us\tallocs_per_query\tpeak_rss_added_mb\twords_found" << endl;
+
+  for (size_t i = 0; i < settings.sizes.size(); i++) {
+    // Each size gets its own stream, so adding a size doesn't change the
+    // dictionaries of the others.
+    mt19937 random(settings.seed + settings.sizes[i]);
+    vector<string> dictionary = makeDictionary(settings.sizes[i], random);
+    vector<string> queries = makeQueries(settings, random);
+    string firstEngine;       // The first search to answer every query.
+    long long firstFound = 0;
+
+    for (size_t j = 0; j < settings.engines.size(); j++) {
+      BenchCounts counts = {0, 0};
+      int results[2];         // The child writes its counts to results[1].
+
+      cout.flush();
+      if (pipe(results) != 0) {
+        cerr << "ERROR! Can't make a pipe" << endl;
+        return 1;
+      }
+      pid_t child = fork();
+
+      if (child == 0) {
+        close(results[0]);
+        counts = benchEngine(settings, settings.engines[j], dictionary, queries);
+        if (write(results[1], &counts, sizeof(counts)) != sizeof(counts))
+          _exit(1);
+        _exit(0);
+      }
+
+      close(results[1]);
+      if (read(results[0], &counts, sizeof(counts)) != sizeof(counts))
+        counts.queriesRun = 0;
+      close(results[0]);
+      waitpid(child, NULL, 0);
+
+      // A search stopped by the budget found words for fewer queries.
+      if (counts.queriesRun != (long long)queries.size())
+        continue;
+
+      if (firstEngine.empty()) {
+        firstEngine = settings.engines[j];
+        firstFound = counts.wordsFound;
+      } else if (counts.wordsFound != firstFound) {
+        cerr << "ERROR! " << settings.engines[j] << " found "
+             << counts.wordsFound << " words, " << firstEngine << " found "
+             << firstFound << endl;
+        agreed = false;
+      }
+    }
+  }
+
+  return agreed ? 0 : 1;
+}
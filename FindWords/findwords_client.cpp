@@ -0,0 +1,105 @@
+/*******************************************************************************
+Title:         findwords_client.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Sends queries to a findwords server and prints its answers.
+Purpose:       Tests the server without writing socket code.
+Usage:         ./findwords_client /tmp/findwords.sock stop pots tops
+                    OR
+               ./findwords_client /tmp/findwords.sock < queries.txt
+Build with:    g++ -o findwords_client findwords_client.cpp
+********************************************************************************/
+#include <cstring>
+#include <string>
+#include <iostream>
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+using namespace std;
+
+// Writes what the socket takes of the queries not sent yet, without
+// waiting. Returns false if the server went away.
+bool sendSome(int server, const string& text, size_t& sent) {
+  ssize_t written = send(server, text.data() + sent, text.length() - sent,
+                         MSG_DONTWAIT | MSG_NOSIGNAL);
+
+  if (written < 0)
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+  sent += written;
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  struct sockaddr_un address; // Where the server listens.
+  string requests,            // Every query, one per line.
+         line;                // One line of standard input.
+  char buffer[4096];          // Holds part of the answers.
+  size_t sent = 0;            // How much of requests has been written.
+  ssize_t length = 1;
+  int server;
+
+  if (argc < 2 || strlen(argv[1]) >= sizeof(address.sun_path)) {
+    cerr << "Usage: " << argv[0] << " socketpath [query ...]" << endl;
+    return 1;
+  }
+
+  // Queries come from the command line, or from standard input if none.
+  if (argc > 2) {
+    for (int i = 2; i < argc; i++)
+      requests += string(argv[i]) + "\n";
+  } else {
+    while (getline(cin, line))
+      requests += line + "\n";
+  }
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, argv[1]);
+
+  server = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server < 0 || connect(server, (struct sockaddr*)&address, sizeof(address)) != 0) {
+    cerr << "ERROR! Cannot connect to " << argv[1] << endl;
+    return 1;
+  }
+
+  // Answers are read while queries are still being sent, since the server
+  // stops reading a client whose answers pile up. Closing our side tells
+  // the server there are no more queries, it closes its side once every
+  // answer is sent.
+  if (requests.empty())
+    shutdown(server, SHUT_WR);
+
+  while (length > 0) {
+    struct pollfd wanted = {server, POLLIN, 0};
+
+    if (sent < requests.length())
+      wanted.events |= POLLOUT;
+    if (poll(&wanted, 1, -1) < 0) {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+
+    if (wanted.revents & POLLOUT) {
+      if (!sendSome(server, requests, sent)) {
+        cerr << "ERROR! The server closed the connection" << endl;
+        return 1;
+      }
+      if (sent == requests.length())
+        shutdown(server, SHUT_WR);
+    }
+
+    if (wanted.revents & (POLLIN | POLLHUP | POLLERR)) {
+      length = read(server, buffer, sizeof(buffer));
+      if (length > 0)
+        cout.write(buffer, length);
+      else if (length < 0 && errno == EINTR)
+        length = 1;
+    }
+  }
+
+  close(server);
+  return 0;
+}
@@ -0,0 +1,335 @@
+/*******************************************************************************
+Title:         findwords_verify.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Makes up dictionaries and queries, answers every query with
+               the legacy search and with each of the others, and reports
+               any query where they find different words, along with how
+               long each search took.
+Purpose:       Shows that a faster search finds exactly what findWords and
+               inDictionary find before it replaces them. The same seed makes
+               the same dictionaries and queries, so a failure can be repeated.
+Usage:         ./findwords_verify [--seed N] [--rounds N] [--words N]
+                                  [--queries N] [--lengths 2-10] [--blanks N]
+                                  [--engines sorted,trie,anagram,histogram,louds]
+               Exits with 1 if any search disagrees with the legacy search.
+Build with:    g++ -O2 -o findwords_verify findwords_verify.cpp dictionary.cpp
+               trie.cpp compiled_dictionary.cpp anagram_index.cpp
+               word_finder.cpp histogram_filter.cpp pattern_index.cpp
+               word_score.cpp louds_trie.cpp prefix_filter.cpp search_stats.cpp
+               result_cache.cpp -pthread
+********************************************************************************/
+#include "word_finder.h"
+
+#include <chrono>
+#include <random>
+#include <sstream>
+
+// The letters words and queries are made of, repeated about as often as
+// they are in English so the searches meet realistic prefixes.
+const string LETTERS = "eeeeeeeeeeeetttttttttaaaaaaaaoooooooiiiiiiinnnnnnn"
+                       "sssssshhhhhhrrrrrrddddllllcccuuummmwwffggyyppbbvkjxqz";
+
+// The ways each query is answered, each compared on its own.
+enum VerifyMode {
+  ALL_MODE,       // Every word.
+  EXACT_MODE,     // Only the words using every letter.
+  PARALLEL_MODE,  // Every word, with the search split between threads.
+  TOP_MODE,       // The best scoring words, compared by their scores.
+  MODE_COUNT
+};
+
+const char* MODE_NAMES[MODE_COUNT] = {"all", "exact", "parallel", "top"};
+
+// The most differences shown before the rest are only counted.
+const int MAX_REPORTS = 20;
+
+// What one run of the harness is set to.
+struct VerifySettings {
+  unsigned int seed;        // Seeds every random choice.
+  int rounds;               // Dictionaries made, each with its own queries.
+  int wordCount;            // Words in each dictionary.
+  int queryCount;           // Queries per dictionary.
+  int minLength,            // Shortest query.
+      maxLength;            // Longest query.
+  int maxBlanks;            // Most blanks in a query.
+  vector<string> engines;   // Names of the searches checked against legacy.
+  int threadCount;          // Threads of the parallel mode.
+  int topCount;             // Words of the top mode.
+};
+
+// Makes a sorted dictionary, 2 to 10 letters a word, with some words twice.
+// The legacy search only checks the first word starting with a prefix, so
+// it needs a sorted dictionary like the word lists it was written for.
+vector<string> makeDictionary(int size, mt19937& random) {
+  uniform_int_distribution<int> letter(0, LETTERS.length() - 1),
+                                length(2, 10),
+                                percent(0, 99);
+  vector<string> dictionary;
+
+  while (dictionary.size() < size) {
+    string word;
+    int wordLength = length(random);
+
+    for (int i = 0; i < wordLength; i++)
+      word += LETTERS[letter(random)];
+
+    dictionary.push_back(word);
+    if (percent(random) < 2)
+      dictionary.push_back(word);
+  }
+
+  sort(dictionary.begin(), dictionary.end());
+  return dictionary;
+}
+
+// Makes queries with lengths spread evenly between the settings' limits,
+// and up to maxBlanks of their letters replaced by blanks.
+vector<string> makeQueries(const VerifySettings& settings, mt19937& random) {
+  uniform_int_distribution<int> letter(0, LETTERS.length() - 1),
+                                length(settings.minLength, settings.maxLength),
+                                blanks(0, settings.maxBlanks);
+  vector<string> queries;
+
+  for (int i = 0; i < settings.queryCount; i++) {
+    string query;
+    int queryLength = length(random);
+
+    for (int j = 0; j < queryLength; j++)
+      query += LETTERS[letter(random)];
+
+    for (int j = blanks(random); j > 0; j--)
+      query[uniform_int_distribution<int>(0, queryLength - 1)(random)] = BLANK;
+
+    queries.push_back(query);
+  }
+
+  return queries;
+}
+
+// Sets a finder up to answer queries in one mode.
+void useMode(WordFinder& finder, int mode, const VerifySettings& settings,
+             const ScoreTable& scores) {
+  finder.setExactOnly(mode == EXACT_MODE);
+  finder.setSearchThreads(mode == PARALLEL_MODE ? settings.threadCount : 1);
+  finder.setTopWords(mode == TOP_MODE ? settings.topCount : 0, scores);
+}
+
+// Turns what a search found into something that can be compared between
+// searches. Positions differ from search to search, so words are compared,
+// sorted and without repeats. Equal scores may be broken by different
+// words, so the best words are compared by their scores.
+vector<string> answerOf(const WordFinder& finder, const string& query,
+                        const vector<int>& foundWordPositions, int mode) {
+  vector<string> answer;
+
+  for (int i = 0; i < foundWordPositions.size(); i++) {
+    if (mode == TOP_MODE)
+      answer.push_back(to_string(finder.score(foundWordPositions[i], query)));
+    else
+      answer.push_back(finder.word(foundWordPositions[i]));
+  }
+
+  if (mode != TOP_MODE) {
+    sort(answer.begin(), answer.end());
+    answer.erase(unique(answer.begin(), answer.end()), answer.end());
+  }
+
+  return answer;
+}
+
+// Returns the items of one list that aren't in another, both sorted.
+vector<string> difference(const vector<string>& first,
+                          const vector<string>& second) {
+  vector<string> missing;
+
+  set_difference(first.begin(), first.end(), second.begin(), second.end(),
+                 back_inserter(missing));
+  return missing;
+}
+
+// Returns the items of a list separated by spaces.
+string listed(const vector<string>& items) {
+  string line;
+
+  for (int i = 0; i < items.size(); i++)
+    line += (i > 0 ? " " : "") + items[i];
+  return line;
+}
+
+// Answers every query with a finder in every mode, and times each mode.
+//
+// @WordFinder& finder:               the search to run.
+// @VerifySettings& settings:         the modes' settings.
+// @ScoreTable& scores:               how the top mode scores words.
+// @vector<string>& queries:          the queries.
+// @vector<vector<string> > answers[]: filled with each mode's answers.
+// @double seconds[]:                 each mode's time is added.
+void answerAll(WordFinder& finder, const VerifySettings& settings,
+               const ScoreTable& scores, const vector<string>& queries,
+               vector<vector<string> > answers[], double seconds[]) {
+  typedef chrono::steady_clock Clock;
+  vector<int> foundWordPositions;
+
+  for (int mode = 0; mode < MODE_COUNT; mode++) {
+    useMode(finder, mode, settings, scores);
+    answers[mode].clear();
+
+    for (int i = 0; i < queries.size(); i++) {
+      Clock::time_point before = Clock::now();
+      finder.findWords(queries[i], foundWordPositions);
+      seconds[mode] += chrono::duration<double>(Clock::now() - before).count();
+
+      answers[mode].push_back(answerOf(finder, queries[i], foundWordPositions,
+                                       mode));
+    }
+  }
+}
+
+// Splits a comma separated list.
+vector<string> splitList(const string& list) {
+  vector<string> items;
+  istringstream stream(list);
+  string item;
+
+  while (getline(stream, item, ','))
+    if (!item.empty())
+      items.push_back(item);
+
+  return items;
+}
+
+int main(int argc, char *argv[]) {
+  VerifySettings settings;
+  ScoreTable scores;
+  bool seeded = false;
+  long long checks = 0,
+            differences = 0;
+
+  settings.seed = 0;
+  settings.rounds = 10;
+  settings.wordCount = 2000;
+  settings.queryCount = 200;
+  settings.minLength = 2;
+  settings.maxLength = 10;
+  settings.maxBlanks = 2;
+  settings.engines = splitList("sorted,trie,anagram,histogram,louds");
+  settings.threadCount = 3;
+  settings.topCount = 5;
+  defaultScores(scores);
+
+  for (int i = 1; i < argc; i++) {
+    string argument = argv[i];
+
+    if (argument == "--seed" && i+1 < argc) {
+      settings.seed = strtoul(argv[++i], NULL, 10);
+      seeded = true;
+    } else if (argument == "--rounds" && i+1 < argc) {
+      settings.rounds = atoi(argv[++i]);
+    } else if (argument == "--words" && i+1 < argc) {
+      settings.wordCount = atoi(argv[++i]);
+    } else if (argument == "--queries" && i+1 < argc) {
+      settings.queryCount = atoi(argv[++i]);
+    } else if (argument == "--lengths" && i+1 < argc) {
+      if (sscanf(argv[++i], "%d-%d", &settings.minLength, &settings.maxLength) != 2 ||
+          settings.minLength < MIN_QUERY_LENGTH ||
+          settings.maxLength > MAX_QUERY_LENGTH) {
+        cerr << "ERROR! Lengths look like 2-10, and go up to "
+             << MAX_QUERY_LENGTH << endl;
+        return 1;
+      }
+    } else if (argument == "--blanks" && i+1 < argc) {
+      settings.maxBlanks = min(atoi(argv[++i]), MAX_BLANKS);
+    } else if (argument == "--engines" && i+1 < argc) {
+      settings.engines = splitList(argv[++i]);
+    } else {
+      cerr << "Usage: " << argv[0] << " [--seed N] [--rounds N] [--words N]"
+           << " [--queries N] [--lengths 2-10] [--blanks N]"
+           << " [--engines sorted,trie,anagram,histogram,louds]" << endl;
+      return 1;
+    }
+  }
+
+  for (int i = 0; i < settings.engines.size(); i++) {
+    SearchEngine engine;
+    if (!engineFromName(settings.engines[i], engine)) {
+      cerr << "ERROR! Unknown engine: " << settings.engines[i] << endl;
+      return 1;
+    }
+  }
+
+  // Without a seed every run is different, print it so a run can be repeated.
+  if (!seeded)
+    settings.seed = random_device()();
+
+  cout << "seed " << settings.seed << ", " << settings.rounds << " rounds of "
+       << settings.wordCount << " words and " << settings.queryCount
+       << " queries of " << settings.minLength << "-" << settings.maxLength
+       << " letters" << endl;
+
+  // The time each search spent in each mode, legacy's first.
+  vector<vector<double> > seconds(settings.engines.size() + 1,
+                                  vector<double>(MODE_COUNT, 0));
+
+  for (int round = 0; round < settings.rounds; round++) {
+    // Each round gets its own stream, so a failing round can be told apart.
+    mt19937 random(settings.seed + round);
+    vector<string> dictionary = makeDictionary(settings.wordCount, random);
+    vector<string> queries = makeQueries(settings, random);
+    vector<vector<string> > expected[MODE_COUNT],
+                            found[MODE_COUNT];
+
+    {
+      WordFinder legacy;
+      legacy.useWords(dictionary, LEGACY_ENGINE);
+      answerAll(legacy, settings, scores, queries, expected, &seconds[0][0]);
+    }
+
+    for (int j = 0; j < settings.engines.size(); j++) {
+      WordFinder finder;
+      SearchEngine engine;
+
+      engineFromName(settings.engines[j], engine);
+      finder.useWords(dictionary, engine);
+      answerAll(finder, settings, scores, queries, found, &seconds[j + 1][0]);
+
+      for (int mode = 0; mode < MODE_COUNT; mode++) {
+        for (int i = 0; i < queries.size(); i++) {
+          checks++;
+          if (found[mode][i] == expected[mode][i])
+            continue;
+
+          if (++differences <= MAX_REPORTS) {
+            cout << "DIFFERENT: round " << round << ", " << settings.engines[j]
+                 << " " << MODE_NAMES[mode] << ", " << queries[i];
+            if (mode == TOP_MODE)
+              cout << ": scores [" << listed(found[mode][i]) << "] expected ["
+                   << listed(expected[mode][i]) << "]" << endl;
+            else
+              cout << ": missing ["
+                   << listed(difference(expected[mode][i], found[mode][i]))
+                   << "] extra ["
+                   << listed(difference(found[mode][i], expected[mode][i]))
+                   << "]" << endl;
+          }
+        }
+      }
+    }
+  }
+
+  // Every search's time next to legacy's, mode by mode.
+  cout << "engine\tmode\tqueries\ttotal_ms\tspeedup" << endl;
+  for (int j = 0; j <= settings.engines.size(); j++) {
+    for (int mode = 0; mode < MODE_COUNT; mode++) {
+      cout << (j == 0 ? "legacy" : settings.engines[j - 1]) << '\t'
+           << MODE_NAMES[mode] << '\t'
+           << (long long)settings.rounds * settings.queryCount << '\t'
+           << seconds[j][mode] * 1000 << '\t'
+           << (seconds[j][mode] > 0 ? seconds[0][mode] / seconds[j][mode] : 0)
+           << endl;
+    }
+  }
+
+  cout << checks << " answers checked, " << differences << " different" << endl;
+  return differences == 0 ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+/*******************************************************************************
+Title:         histogram_filter.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Keeps a count of each letter of every word next to each other,
+               and compares all of them against the user's letters.
+Purpose:       Finds words with the same amount of work for every input, no
+               matter which letters lead the search down long dead ends.
+Usage:         ./findwords --engine histogram dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+               Add -mavx2 to compare 32 letter counts at once instead of 16.
+********************************************************************************/
+#include "histogram_filter.h"
+#include "search_stats.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// ***** Helpers *****
+
+// Checks that no count of a word is more than the same count of the query.
+// A word fits when max(word, query) is the query for every letter.
+static inline bool fits(const unsigned char* word, const unsigned char* query) {
+#if defined(__AVX2__)
+  __m256i wordCounts  = _mm256_loadu_si256((const __m256i*)word),
+          queryCounts = _mm256_loadu_si256((const __m256i*)query),
+          same = _mm256_cmpeq_epi8(_mm256_max_epu8(wordCounts, queryCounts),
+                                   queryCounts);
+  return _mm256_movemask_epi8(same) == -1;
+#elif defined(__SSE2__)
+  __m128i low  = _mm_loadu_si128((const __m128i*)word),
+          high = _mm_loadu_si128((const __m128i*)(word + 16)),
+          queryLow  = _mm_loadu_si128((const __m128i*)query),
+          queryHigh = _mm_loadu_si128((const __m128i*)(query + 16)),
+          same = _mm_and_si128(
+              _mm_cmpeq_epi8(_mm_max_epu8(low, queryLow), queryLow),
+              _mm_cmpeq_epi8(_mm_max_epu8(high, queryHigh), queryHigh));
+  return _mm_movemask_epi8(same) == 0xFFFF;
+#else
+  bool fit = true;
+  for (int i = 0; i < HISTOGRAM_SIZE; i++)
+    fit &= word[i] <= query[i];
+  return fit;
+#endif
+}
+
+// Returns how many letters a word needs beyond the query's counts, the
+// number of blanks it would take. Subtracting with saturation leaves only
+// the letters the query is short of, and summing absolute differences
+// against zero adds them up.
+static inline int missing(const unsigned char* word, const unsigned char* query) {
+#if defined(__AVX2__)
+  __m256i over = _mm256_subs_epu8(_mm256_loadu_si256((const __m256i*)word),
+                                    _mm256_loadu_si256((const __m256i*)query)),
+          sums = _mm256_sad_epu8(over, _mm256_setzero_si256());
+  return _mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+         _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3);
+#elif defined(__SSE2__)
+  __m128i low  = _mm_subs_epu8(_mm_loadu_si128((const __m128i*)word),
+                               _mm_loadu_si128((const __m128i*)query)),
+          high = _mm_subs_epu8(_mm_loadu_si128((const __m128i*)(word + 16)),
+                               _mm_loadu_si128((const __m128i*)(query + 16))),
+          sums = _mm_add_epi64(_mm_sad_epu8(low, _mm_setzero_si128()),
+                               _mm_sad_epu8(high, _mm_setzero_si128()));
+  return _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+#else
+  int total = 0;
+  for (int i = 0; i < HISTOGRAM_SIZE; i++)
+    total += word[i] > query[i] ? word[i] - query[i] : 0;
+  return total;
+#endif
+}
+
+// ***** Function Definitions *****
+
+// Default constructor, an empty filter.
+HistogramFilter::HistogramFilter() {}
+
+// Counts the letters of every word of the dictionary.
+void HistogramFilter::build(const vector<string>& dictionary) {
+  vector<int> order;  // Positions of the words that can be found.
+  ByWordAt byWord;
+
+  histograms.clear();
+  wordPositions.clear();
+
+  for (int i = 0; i < dictionary.size(); i++) {
+    if (dictionary[i].length() >= MIN_WORD_LENGTH && isPlainWord(dictionary[i]))
+      order.push_back(i);
+  }
+
+  // Drop repeated words, keeping the first copy, then go back to the
+  // dictionary's order.
+  byWord.dictionary = &dictionary;
+  stable_sort(order.begin(), order.end(), byWord);
+
+  for (int i = 0; i < order.size(); i++) {
+    if (i == 0 || dictionary[order[i]] != dictionary[order[i-1]])
+      wordPositions.push_back(order[i]);
+  }
+
+  sort(wordPositions.begin(), wordPositions.end());
+
+  histograms.resize(wordPositions.size() * HISTOGRAM_SIZE);
+  for (int i = 0; i < wordPositions.size(); i++)
+    countLetters(dictionary[wordPositions[i]], &histograms[i * HISTOGRAM_SIZE]);
+}
+
+// Finds all words whose letter counts are no more than the counts of letters.
+void HistogramFilter::findWords(const string& letters,
+                                vector<int>& foundWordPositions) const {
+  unsigned char query[HISTOGRAM_SIZE]; // The counts of the user's letters.
+  int wordCount = wordPositions.size(),
+      blanks = countBlanks(letters),
+      alreadyFound = foundWordPositions.size();
+
+  countLetters(letters, query);
+
+  // Every word gets the same comparison, there is nothing to prune.
+  if (blanks == 0) {
+    for (int i = 0; i < wordCount; i++) {
+      if (fits(&histograms[i * HISTOGRAM_SIZE], query))
+        foundWordPositions.push_back(wordPositions[i]);
+    }
+    countProbes(wordCount, foundWordPositions.size() - alreadyFound);
+    return;
+  }
+
+  // With blanks a word fits when they cover every letter it is short of.
+  for (int i = 0; i < wordCount; i++) {
+    if (missing(&histograms[i * HISTOGRAM_SIZE], query) <= blanks)
+      foundWordPositions.push_back(wordPositions[i]);
+  }
+  countProbes(wordCount, foundWordPositions.size() - alreadyFound);
+}
+
+// Returns the number of words in the filter.
+int HistogramFilter::size() const {
+  return wordPositions.size();
+}
+
+// Returns the bytes the histograms use.
+size_t HistogramFilter::memoryUsed() const {
+  return histograms.capacity() + wordPositions.capacity() * sizeof(int);
+}
+
+// Counts each letter a to z of a word. Counts stop at 255.
+void countLetters(const string& word, unsigned char histogram[]) {
+  memset(histogram, 0, HISTOGRAM_SIZE);
+
+  for (int i = 0; i < word.length(); i++) {
+    if (word[i] >= 'a' && word[i] <= 'z' && histogram[word[i] - 'a'] < 255)
+      histogram[word[i] - 'a']++;
+  }
+}
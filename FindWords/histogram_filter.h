@@ -0,0 +1,74 @@
+/*******************************************************************************
+Title:         histogram_filter.h
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Keeps a count of each letter of every word next to each other,
+               and compares all of them against the user's letters.
+Purpose:       Finds words with the same amount of work for every input, no
+               matter which letters lead the search down long dead ends.
+Usage:         ./findwords --engine histogram dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+               Add -mavx2 to compare 32 letter counts at once instead of 16.
+********************************************************************************/
+
+#ifndef HISTOGRAM_FILTER_H
+#define HISTOGRAM_FILTER_H
+
+#include "dictionary.h"
+
+// Bytes kept for each word's letter counts. Only 26 are used, the rest stay
+// zero so every word fills exactly one 32 byte vector.
+const int HISTOGRAM_SIZE = 32;
+
+class HistogramFilter {
+private:
+  vector<unsigned char> histograms; // HISTOGRAM_SIZE counts for every word.
+  vector<int> wordPositions;        // Dictionary position of every word.
+
+public:
+  // Default constructor, an empty filter.
+  HistogramFilter();
+
+  // Counts the letters of every word of the dictionary.
+  //
+  // Precondition:  A dictionary exists, it doesn't need to be sorted.
+  // Postcondition: Every word made of the letters a to z and at least
+  //                MIN_WORD_LENGTH long is in the filter, repeated words
+  //                only once.
+  //
+  // @vector<string>& dictionary:       a populated list of words.
+  void build(const vector<string>& dictionary);
+
+  // Finds all words whose letter counts are no more than the counts of
+  // letters, by comparing every word. Each blank in letters makes up for
+  // one letter a word is short of.
+  //
+  // Precondition:  The filter has been built.
+  // Postcondition: The positions of the words have been added, once each.
+  //
+  // @string& letters:                  the letters of the user's word.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void findWords(const string& letters, vector<int>& foundWordPositions) const;
+
+  // Returns the number of words in the filter.
+  int size() const;
+
+  // Returns the bytes the histograms use.
+  size_t memoryUsed() const;
+};
+
+
+// Counts each letter a to z of a word. Counts stop at 255.
+//
+// Precondition:  histogram has room for HISTOGRAM_SIZE counts.
+// Postcondition: histogram holds the word's letter counts, and zeros after.
+//
+// @string& word:                    the word to be counted.
+// @unsigned char histogram[]:       where the counts are written.
+void countLetters(const string& word, unsigned char histogram[]);
+
+#endif
@@ -0,0 +1,384 @@
+/*******************************************************************************
+Title:         louds_trie.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   A trie of the dictionary stored as bits, the shape of the tree
+               level by level (LOUDS), a letter per node and a bit for each
+               node a word ends at. Rank and select on the bits move between
+               a node, its children and its parent.
+Purpose:       Keeps a large dictionary in a few bytes per word instead of a
+               string per word, while still answering the same prefix and word
+               queries as inDictionary and the same searches as the trie.
+Usage:         ./findwords --engine louds dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+#include "louds_trie.h"
+#include "search_stats.h"
+
+// ***** Helpers *****
+
+// The 64 bit words counted together. Rank adds up at most this many words
+// past its block's count, which costs a 32 bit count per 512 bits.
+const int BLOCK_WORDS = 8;
+const int BLOCK_BITS = BLOCK_WORDS * 64;
+
+// A node whose children haven't been added yet, and the range of sorted
+// words that go through it.
+struct LoudsPending {
+  int lo,     // First word of the range.
+      hi,     // One past the last word of the range.
+      depth;  // Length of the prefix leading to the node.
+};
+
+// Returns the position of the k-th 1 of a word, counting from 0.
+static int selectInWord(unsigned long long word, int k) {
+  for (int i = 0; i < k; i++)
+    word &= word - 1;
+  return __builtin_ctzll(word);
+}
+
+// ***** BitVector *****
+
+// Default constructor, no bits.
+BitVector::BitVector() {
+  length = 0;
+}
+
+// Adds a bit to the end.
+void BitVector::push(bool bit) {
+  if (length % 64 == 0)
+    bits.push_back(0);
+  if (bit)
+    bits.back() |= 1ULL << (length % 64);
+  length++;
+}
+
+// Counts the 1s of every block.
+void BitVector::finish() {
+  int ones = 0;
+
+  bits.shrink_to_fit();
+  blockRanks.clear();
+
+  for (int i = 0; i < bits.size(); i++) {
+    if (i % BLOCK_WORDS == 0)
+      blockRanks.push_back(ones);
+    ones += __builtin_popcountll(bits[i]);
+  }
+  blockRanks.push_back(ones);
+  blockRanks.shrink_to_fit();
+}
+
+// Removes every bit.
+void BitVector::clear() {
+  bits.clear();
+  blockRanks.clear();
+  length = 0;
+}
+
+// Returns the bit at a position.
+bool BitVector::get(int position) const {
+  return (bits[position / 64] >> (position % 64)) & 1;
+}
+
+// Returns the number of 1s before a position.
+int BitVector::rank(int position) const {
+  int block = position / BLOCK_BITS,
+      ones = blockRanks[block];
+
+  for (int i = block * BLOCK_WORDS; i < position / 64; i++)
+    ones += __builtin_popcountll(bits[i]);
+
+  if (position % 64 != 0)
+    ones += __builtin_popcountll(bits[position / 64] &
+                                 ((1ULL << (position % 64)) - 1));
+  return ones;
+}
+
+// Returns the position of the k-th 1, counting from 0.
+int BitVector::select1(int k) const {
+  int lo = 0,                         // The block holding the k-th 1 is the
+      hi = blockRanks.size() - 2;     // last with no more than k 1s before it.
+
+  while (lo < hi) {
+    int middle = (lo + hi + 1) / 2;
+    if (blockRanks[middle] <= k)
+      lo = middle;
+    else
+      hi = middle - 1;
+  }
+
+  k -= blockRanks[lo];
+  for (int i = lo * BLOCK_WORDS; ; i++) {
+    int ones = __builtin_popcountll(bits[i]);
+    if (k < ones)
+      return i * 64 + selectInWord(bits[i], k);
+    k -= ones;
+  }
+}
+
+// Returns the position of the k-th 0, counting from 0.
+int BitVector::select0(int k) const {
+  int lo = 0,
+      hi = blockRanks.size() - 2;
+
+  // The 0s before a block are its bits less its 1s.
+  while (lo < hi) {
+    int middle = (lo + hi + 1) / 2;
+    if (middle * BLOCK_BITS - blockRanks[middle] <= k)
+      lo = middle;
+    else
+      hi = middle - 1;
+  }
+
+  k -= lo * BLOCK_BITS - blockRanks[lo];
+  for (int i = lo * BLOCK_WORDS; ; i++) {
+    int zeros = __builtin_popcountll(~bits[i]);
+    if (k < zeros)
+      return i * 64 + selectInWord(~bits[i], k);
+    k -= zeros;
+  }
+}
+
+// Returns the position of the first 0 from a position on.
+int BitVector::nextZero(int position) const {
+  int i = position / 64;
+  unsigned long long zeros = ~bits[i] >> (position % 64);
+
+  if (zeros != 0)
+    return position + __builtin_ctzll(zeros);
+
+  while (~bits[++i] == 0) {}
+  return i * 64 + __builtin_ctzll(~bits[i]);
+}
+
+// Returns the number of bits.
+int BitVector::size() const {
+  return length;
+}
+
+// Returns the bytes the bits and counts use.
+size_t BitVector::memoryUsed() const {
+  return bits.capacity() * sizeof(unsigned long long) +
+         blockRanks.capacity() * sizeof(int);
+}
+
+// ***** LoudsTrie *****
+
+// Default constructor, an empty trie.
+LoudsTrie::LoudsTrie() {}
+
+// Builds the trie from a dictionary.
+void LoudsTrie::build(const vector<string>& dictionary) {
+  vector<int> order(dictionary.size()); // Positions of the words, sorted.
+  vector<LoudsPending> pending;         // Nodes waiting for their children,
+  ByWordAt byWord;                      // one per node in the node's order.
+
+  for (int i = 0; i < order.size(); i++)
+    order[i] = i;
+
+  byWord.dictionary = &dictionary;
+  sort(order.begin(), order.end(), byWord);
+
+  LoudsPending all = {0, (int)order.size(), 0};
+  shape.clear();
+  wordEnds.clear();
+  labels.clear();
+  labels.push_back(0);
+  pending.push_back(all);
+
+  // Handle the nodes in the order they were made, which numbers them level
+  // by level, and gives each node's children the numbers after its siblings'.
+  for (int i = 0; i < pending.size(); i++) {
+    LoudsPending current = pending[i];
+    int lo = current.lo;
+    bool ends = false;
+
+    // Every copy of the word ending at this node sorts before longer words.
+    while (lo < current.hi && dictionary[order[lo]].length() == current.depth) {
+      ends = true;
+      lo++;
+    }
+    wordEnds.push(ends);
+
+    // Every different next letter in the range is a child.
+    while (lo < current.hi) {
+      char letter = dictionary[order[lo]][current.depth];
+      int hi = lo;
+
+      while (hi < current.hi && dictionary[order[hi]][current.depth] == letter)
+        hi++;
+
+      LoudsPending next = {lo, hi, current.depth + 1};
+      pending.push_back(next);
+      labels.push_back(letter);
+      shape.push(true);
+
+      lo = hi;
+    }
+    shape.push(false);
+  }
+
+  labels.shrink_to_fit();
+  shape.finish();
+  wordEnds.finish();
+}
+
+// Finds the children of a node.
+void LoudsTrie::children(int node, int& first, int& count) const {
+  // A node's run starts after the 0 ending the run of the node before it.
+  int start = node == 0 ? 0 : shape.select0(node - 1) + 1,
+      end = shape.select0(node);
+
+  // The root is no one's child, so the n-th 1 leads to node n + 1.
+  first = shape.rank(start) + 1;
+  count = end - start;
+}
+
+// Returns the parent of a node.
+int LoudsTrie::parent(int node) const {
+  int position = shape.select1(node - 1);
+
+  // The parent is the node whose run the 1 is in, one per 0 before it.
+  return position - shape.rank(position);
+}
+
+// Returns the child of a node reached with a letter, or -1 if none is.
+int LoudsTrie::child(int node, char letter) const {
+  int first, count;
+
+  children(node, first, count);
+
+  // The children are in alphabetical order.
+  const char* found = lower_bound(labels.data() + first,
+                                  labels.data() + first + count, letter);
+  if (found == labels.data() + first + count || *found != letter)
+    return -1;
+  return found - labels.data();
+}
+
+// Returns the node a prefix ends at, or -1 if no word starts with it.
+int LoudsTrie::follow(string_view prefix) const {
+  int node = 0;
+
+  if (labels.empty())
+    return -1;
+
+  for (int i = 0; i < prefix.length() && node != -1; i++)
+    node = child(node, prefix[i]);
+
+  return node;
+}
+
+// Checks if any word starts with a prefix.
+bool LoudsTrie::hasPrefix(string_view prefix) const {
+  return follow(prefix) != -1;
+}
+
+// Returns the number of a word, or -1 if it isn't in the dictionary.
+int LoudsTrie::find(string_view word) const {
+  int node = follow(word);
+
+  if (node == -1 || !wordEnds.get(node))
+    return -1;
+  return wordEnds.rank(node);
+}
+
+// Finds all words that can be made out of letters.
+void LoudsTrie::findWords(const string& letters,
+                          vector<int>& foundWordPositions) const {
+  int letterCounts[26] = {0}; // How many of each letter can still be used.
+
+  if (size() == 0)
+    return;
+
+  // Only the letters a to z are in the search.
+  for (int i = 0; i < letters.length(); i++) {
+    if (letters[i] >= 'a' && letters[i] <= 'z')
+      letterCounts[letters[i] - 'a']++;
+  }
+
+  search(0, 1, letterCounts, countBlanks(letters), 0, foundWordPositions);
+}
+
+// Finds all words below a node that can be made with the letters left.
+void LoudsTrie::search(int start, int firstChild, int letterCounts[],
+                       int blanks, int depth,
+                       vector<int>& foundWordPositions) const {
+  int count = shape.nextZero(start) - start;
+
+  countNode(depth);
+  if (count == 0)
+    return;
+
+  // The children's runs come one after another, as do their children.
+  int childStart = shape.select0(firstChild - 1) + 1,
+      grandchild = shape.rank(childStart) + 1;
+
+  for (int i = firstChild; i < firstChild + count; i++) {
+    int childEnd = shape.nextZero(childStart),
+        letter = labels[i] - 'a';
+
+    // A blank is only used once the letter runs out, the same as the trie.
+    bool blank = letter >= 0 && letter < 26 && letterCounts[letter] == 0;
+
+    if (letter >= 0 && letter < 26)
+      countProbes(1, !blank || blanks > 0);
+
+    if (letter >= 0 && letter < 26 && (!blank || blanks > 0)) {
+      if (blank)
+        blanks--;
+      else
+        letterCounts[letter]--;
+
+      if (depth + 1 >= MIN_WORD_LENGTH && wordEnds.get(i))
+        foundWordPositions.push_back(wordEnds.rank(i));
+
+      search(childStart, grandchild, letterCounts, blanks, depth + 1,
+             foundWordPositions);
+
+      if (blank)
+        blanks++;
+      else
+        letterCounts[letter]++;
+    }
+
+    grandchild += childEnd - childStart;
+    childStart = childEnd + 1;
+  }
+}
+
+// Returns a word, spelled by following its node back to the root.
+string LoudsTrie::word(int number) const {
+  string spelled;
+
+  for (int node = wordEnds.select1(number); node != 0; node = parent(node))
+    spelled += labels[node];
+
+  reverse(spelled.begin(), spelled.end());
+  return spelled;
+}
+
+// Returns the length of a word, the depth of its node.
+int LoudsTrie::wordLength(int number) const {
+  int length = 0;
+
+  for (int node = wordEnds.select1(number); node != 0; node = parent(node))
+    length++;
+
+  return length;
+}
+
+// Returns the number of words in the trie.
+int LoudsTrie::size() const {
+  return wordEnds.size() == 0 ? 0 : wordEnds.rank(wordEnds.size());
+}
+
+// Returns the bytes the trie uses.
+size_t LoudsTrie::memoryUsed() const {
+  return shape.memoryUsed() + wordEnds.memoryUsed() + labels.capacity();
+}
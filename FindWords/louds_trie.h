@@ -0,0 +1,220 @@
+/*******************************************************************************
+Title:         louds_trie.h
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   A trie of the dictionary stored as bits, the shape of the tree
+               level by level (LOUDS), a letter per node and a bit for each
+               node a word ends at. Rank and select on the bits move between
+               a node, its children and its parent.
+Purpose:       Keeps a large dictionary in a few bytes per word instead of a
+               string per word, while still answering the same prefix and word
+               queries as inDictionary and the same searches as the trie.
+Usage:         ./findwords --engine louds dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+
+#ifndef LOUDS_TRIE_H
+#define LOUDS_TRIE_H
+
+#include "dictionary.h"
+
+// A list of bits that can count the 1s before any bit (rank), and find the
+// bit holding the k-th 1 or 0 (select).
+class BitVector {
+private:
+  vector<unsigned long long> bits;  // The bits, 64 to a word.
+  vector<int> blockRanks;   // The 1s before each block of BLOCK_WORDS words,
+                            // and the 1s of every bit at the end.
+  int length;               // The number of bits.
+
+public:
+  // Default constructor, no bits.
+  BitVector();
+
+  // Adds a bit to the end.
+  //
+  // Precondition:  finish hasn't been called since the last clear.
+  // Postcondition: The bit is the last one.
+  //
+  // @bool bit:                         the bit to add.
+  void push(bool bit);
+
+  // Counts the 1s of every block, which rank and select start from.
+  //
+  // Precondition:  Every bit has been added.
+  // Postcondition: rank, select1 and select0 can be used.
+  void finish();
+
+  // Removes every bit.
+  void clear();
+
+  // Returns the bit at a position.
+  //
+  // Precondition:  0 <= position < size().
+  //
+  // @int position:                     the position of the bit.
+  bool get(int position) const;
+
+  // Returns the number of 1s before a position.
+  //
+  // Precondition:  finish was called, 0 <= position <= size().
+  //
+  // @int position:                     one past the last bit counted.
+  int rank(int position) const;
+
+  // Returns the position of the k-th 1, counting from 0.
+  //
+  // Precondition:  finish was called, 0 <= k < rank(size()).
+  //
+  // @int k:                            which 1 to find.
+  int select1(int k) const;
+
+  // Returns the position of the k-th 0, counting from 0.
+  //
+  // Precondition:  finish was called, 0 <= k < size() - rank(size()).
+  //
+  // @int k:                            which 0 to find.
+  int select0(int k) const;
+
+  // Returns the position of the first 0 from a position on, which is
+  // quicker than select0 when it is near.
+  //
+  // Precondition:  There is a 0 at or after position.
+  //
+  // @int position:                     where to start looking.
+  int nextZero(int position) const;
+
+  // Returns the number of bits.
+  int size() const;
+
+  // Returns the bytes the bits and counts use.
+  size_t memoryUsed() const;
+};
+
+
+// A trie whose nodes are numbered level by level, the root 0. Each node has
+// its children's count in the shape as that many 1s followed by a 0, so the
+// children of a node are the nodes numbered right after the 1s before its
+// own run, and the words are numbered in the order of the nodes they end at,
+// shortest first and in alphabetical order within a length.
+class LoudsTrie {
+private:
+  BitVector shape;          // A run of 1s and a 0 for every node.
+  BitVector wordEnds;       // A 1 for every node a word ends at.
+  vector<char> labels;      // The letter leading to each node.
+
+  // Finds the children of a node.
+  //
+  // Precondition:  0 <= node < the number of nodes.
+  // Postcondition: first is the first child, and first + count is one past
+  //                the last.
+  //
+  // @int node:                         the node.
+  // @int& first:                       the node number of the first child.
+  // @int& count:                       the number of children.
+  void children(int node, int& first, int& count) const;
+
+  // Returns the parent of a node.
+  //
+  // Precondition:  0 < node < the number of nodes.
+  //
+  // @int node:                         the node.
+  int parent(int node) const;
+
+  // Returns the child of a node reached with a letter, or -1 if none is.
+  //
+  // Precondition:  0 <= node < the number of nodes.
+  //
+  // @int node:                         the node.
+  // @char letter:                      the letter to follow.
+  int child(int node, char letter) const;
+
+  // Returns the node a prefix ends at, or -1 if no word starts with it.
+  //
+  // Precondition:  None.
+  //
+  // @string_view prefix:               the letters to follow from the root.
+  int follow(string_view prefix) const;
+
+  // Finds all words below a node that can be made with the letters left.
+  // A blank is only used for a child whose letter has run out. The runs of
+  // a node's children follow each other, so only the first child's run is
+  // looked up with select0.
+  //
+  // Precondition:  The trie has been built.
+  // Postcondition: The numbers of the words below the node that can be
+  //                made have been added.
+  //
+  // @int start:                        where the node's run starts in shape.
+  // @int firstChild:                   the node's first child.
+  // @int letterCounts[]:               how many of each letter are left.
+  // @int blanks:                       how many blanks are left.
+  // @int depth:                        the length of the prefix.
+  // @vector<int>& foundWordPositions:  a list of the numbers of the words found.
+  void search(int start, int firstChild, int letterCounts[], int blanks,
+              int depth, vector<int>& foundWordPositions) const;
+
+public:
+  // Default constructor, an empty trie.
+  LoudsTrie();
+
+  // Builds the trie from a dictionary.
+  //
+  // Precondition:  A dictionary exists, it doesn't need to be sorted.
+  // Postcondition: Every word of the dictionary is in the trie once, the
+  //                trie doesn't point into dictionary, which can be freed.
+  //
+  // @vector<string>& dictionary:       a populated list of words.
+  void build(const vector<string>& dictionary);
+
+  // Checks if any word starts with a prefix, like inDictionary does.
+  //
+  // Precondition:  None.
+  // Postcondition: None.
+  //
+  // @string_view prefix:               the prefix to look for.
+  bool hasPrefix(string_view prefix) const;
+
+  // Returns the number of a word, or -1 if it isn't in the dictionary.
+  //
+  // Precondition:  None.
+  //
+  // @string_view word:                 the word to look for.
+  int find(string_view word) const;
+
+  // Finds all words that can be made out of letters. Each blank in letters
+  // can stand for any letter.
+  //
+  // Precondition:  The trie has been built.
+  // Postcondition: The numbers of the words have been added, once each.
+  //
+  // @string& letters:                  the letters of the user's word.
+  // @vector<int>& foundWordPositions:  a list of the numbers of the words found.
+  void findWords(const string& letters, vector<int>& foundWordPositions) const;
+
+  // Returns a word, spelled by following its node back to the root.
+  //
+  // Precondition:  0 <= number < size().
+  //
+  // @int number:                       the number of the word.
+  string word(int number) const;
+
+  // Returns the length of a word, the depth of its node.
+  //
+  // Precondition:  0 <= number < size().
+  //
+  // @int number:                       the number of the word.
+  int wordLength(int number) const;
+
+  // Returns the number of words in the trie.
+  int size() const;
+
+  // Returns the bytes the trie uses.
+  size_t memoryUsed() const;
+};
+
+#endif
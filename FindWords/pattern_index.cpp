@@ -0,0 +1,259 @@
+/*******************************************************************************
+Title:         pattern_index.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   An index of which words have which letter at which position,
+               kept as one bitmap per length, position and letter.
+Purpose:       Answers crossword style patterns like c?t* by combining a few
+               bitmaps 64 words at a time, instead of reading every word.
+Usage:         ./findwords --patterns dictionaryfile.txt
+               then c?t* or ??r????, and add /aeiou after a pattern to
+               fill its gaps from a pool of letters.
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+#include "pattern_index.h"
+
+// ***** Helpers *****
+
+// Orders positions of the dictionary by the length of their words.
+struct ByLengthAt {
+  const vector<string>* dictionary; // The words being ordered.
+
+  bool operator()(int first, int second) const {
+    return (*dictionary)[first].length() < (*dictionary)[second].length();
+  }
+};
+
+// Finds the first place from start on where a piece of a pattern matches a
+// word, without going past end. Returns -1 if it matches nowhere.
+static int findPiece(const string& word, int start, int end, const string& piece) {
+  for (int i = start; i + (int)piece.length() <= end; i++) {
+    int j = 0;
+    while (j < piece.length() && (piece[j] == BLANK || piece[j] == word[i + j]))
+      j++;
+
+    if (j == piece.length())
+      return i;
+  }
+  return -1;
+}
+
+// Checks the part of a pattern between its first and last * against the
+// letters of a word between start and end. Each piece between two *s is
+// matched as early as it can be, which leaves the most room for the rest.
+static bool matchesMiddle(const string& word, int start, int end,
+                          const string& middle) {
+  size_t pieceStart = 0;
+
+  while (pieceStart <= middle.length()) {
+    size_t pieceEnd = middle.find(ANY_LETTERS, pieceStart);
+    if (pieceEnd == string::npos)
+      pieceEnd = middle.length();
+
+    string piece = middle.substr(pieceStart, pieceEnd - pieceStart);
+    if (!piece.empty()) {
+      int found = findPiece(word, start, end, piece);
+      if (found < 0)
+        return false;
+      start = found + piece.length();
+    }
+
+    pieceStart = pieceEnd + 1;
+  }
+
+  return true;
+}
+
+// ***** Function Definitions *****
+
+// Default constructor, an empty index.
+PatternIndex::PatternIndex() {}
+
+// Indexes every word of the dictionary by its length and letters.
+void PatternIndex::build(const vector<string>& dictionary) {
+  vector<int> order;  // Positions of the words that can be found.
+  ByWordAt byWord;
+  ByLengthAt byLength;
+  int longestWord = 0;
+
+  wordPositions.clear();
+  lengthStart.clear();
+  bitmaps.clear();
+  bitmapStart.clear();
+
+  for (int i = 0; i < dictionary.size(); i++) {
+    if (dictionary[i].length() >= MIN_WORD_LENGTH && isPlainWord(dictionary[i]))
+      order.push_back(i);
+  }
+
+  // Drop repeated words, keeping the first copy, then group the rest by
+  // length, in the dictionary's order within a length.
+  byWord.dictionary = &dictionary;
+  stable_sort(order.begin(), order.end(), byWord);
+
+  for (int i = 0; i < order.size(); i++) {
+    if (i == 0 || dictionary[order[i]] != dictionary[order[i-1]]) {
+      wordPositions.push_back(order[i]);
+      longestWord = max(longestWord, (int)dictionary[order[i]].length());
+    }
+  }
+
+  sort(wordPositions.begin(), wordPositions.end());
+  byLength.dictionary = &dictionary;
+  stable_sort(wordPositions.begin(), wordPositions.end(), byLength);
+
+  // Count the words of each length, then find where each length starts.
+  lengthStart.assign(longestWord + 2, 0);
+  for (int i = 0; i < wordPositions.size(); i++)
+    lengthStart[dictionary[wordPositions[i]].length() + 1]++;
+  for (int length = 1; length < lengthStart.size(); length++)
+    lengthStart[length] += lengthStart[length - 1];
+
+  // Every length gets a bitmap for each of its positions and letters.
+  bitmapStart.assign(longestWord + 2, 0);
+  for (int length = 0; length <= longestWord; length++)
+    bitmapStart[length + 1] = bitmapStart[length] +
+                              (long long)length * 26 * bitmapWords(length);
+  bitmaps.assign(bitmapStart[longestWord + 1], 0);
+
+  for (int length = MIN_WORD_LENGTH; length <= longestWord; length++) {
+    for (int k = 0; k < lengthStart[length + 1] - lengthStart[length]; k++) {
+      const string& word = dictionary[wordPositions[lengthStart[length] + k]];
+
+      for (int position = 0; position < length; position++) {
+        unsigned long long* letterBits = &bitmaps[bitmapStart[length] +
+            ((long long)position * 26 + word[position] - 'a') * bitmapWords(length)];
+        letterBits[k / 64] |= 1ULL << (k % 64);
+      }
+    }
+  }
+}
+
+// Returns the number of 64 bit words in each bitmap of a length.
+int PatternIndex::bitmapWords(int length) const {
+  return (lengthStart[length + 1] - lengthStart[length] + 63) / 64;
+}
+
+// Returns the bitmap of the words of a length with letter at position.
+const unsigned long long* PatternIndex::bitmap(int length, int position,
+                                               int letter) const {
+  return &bitmaps[bitmapStart[length] +
+                  ((long long)position * 26 + letter) * bitmapWords(length)];
+}
+
+// Finds all words matching a pattern.
+bool PatternIndex::findWords(const vector<string>& dictionary,
+                             const string& pattern,
+                             vector<int>& foundWordPositions) const {
+  size_t firstAny = pattern.find(ANY_LETTERS),
+         lastAny  = pattern.rfind(ANY_LETTERS);
+  int letterCount = 0;                  // Letters and ?s, the shortest match.
+  vector<unsigned long long> matches;   // The words of one length still matching.
+
+  for (int i = 0; i < pattern.length(); i++) {
+    if (pattern[i] == ANY_LETTERS)
+      continue;
+    if (pattern[i] != BLANK && (pattern[i] < 'a' || pattern[i] > 'z'))
+      return false;
+    letterCount++;
+  }
+
+  // Without a * only one length can match, and the whole pattern is head.
+  string head = pattern.substr(0, firstAny),
+         tail = firstAny == string::npos ? "" : pattern.substr(lastAny + 1),
+         middle = firstAny == lastAny ? "" :
+                  pattern.substr(firstAny + 1, lastAny - firstAny - 1);
+  int longest = lengthStart.empty() ? -1 : (int)lengthStart.size() - 2,
+      shortest = max(letterCount, MIN_WORD_LENGTH);
+
+  if (firstAny == string::npos)
+    longest = min(longest, letterCount);
+
+  for (int length = shortest; length <= longest; length++) {
+    int words = bitmapWords(length),
+        count = lengthStart[length + 1] - lengthStart[length];
+
+    if (count == 0)
+      continue;
+
+    // Start with every word of the length, then keep only those with the
+    // right letter at each place the pattern fixes.
+    matches.assign(words, ~0ULL);
+    if (count % 64 != 0)
+      matches[words - 1] = (1ULL << (count % 64)) - 1;
+
+    for (int i = 0; i < head.length() + tail.length(); i++) {
+      char letter = i < head.length() ? head[i] : tail[i - head.length()];
+      int position = i < head.length() ? i : length - tail.length() + (i - head.length());
+
+      if (letter == BLANK)
+        continue;
+
+      const unsigned long long* letterBits = bitmap(length, position, letter - 'a');
+      for (int j = 0; j < words; j++)
+        matches[j] &= letterBits[j];
+    }
+
+    for (int j = 0; j < words; j++) {
+      for (unsigned long long bits = matches[j]; bits != 0; bits &= bits - 1) {
+        int position = wordPositions[lengthStart[length] + j * 64 +
+                                     __builtin_ctzll(bits)];
+
+        if (middle.empty() ||
+            matchesMiddle(dictionary[position], head.length(),
+                          length - tail.length(), middle))
+          foundWordPositions.push_back(position);
+      }
+    }
+  }
+
+  return true;
+}
+
+// Returns the number of words in the index.
+int PatternIndex::size() const {
+  return wordPositions.size();
+}
+
+// Returns the bytes the bitmaps use.
+size_t PatternIndex::memoryUsed() const {
+  return bitmaps.size() * sizeof(unsigned long long) +
+         wordPositions.size() * sizeof(int);
+}
+
+// Drops the words whose letters besides the pattern's own can't be made
+// out of a pool of letters.
+void keepFillable(const vector<string>& dictionary, const string& pattern,
+                  const string& letters, vector<int>& foundWordPositions) {
+  LetterPool pool;          // The letters that may fill the gaps.
+  int fixed[26] = {0};      // The letters the pattern already has.
+  int kept = 0;
+
+  makeLetterPool(letters, pool);
+
+  for (int i = 0; i < pattern.length(); i++) {
+    if (pattern[i] >= 'a' && pattern[i] <= 'z')
+      fixed[pattern[i] - 'a']++;
+  }
+
+  for (int i = 0; i < foundWordPositions.size(); i++) {
+    const string& word = dictionary[foundWordPositions[i]];
+    int needed[26] = {0},
+        missing = 0;
+
+    for (int j = 0; j < word.length(); j++)
+      needed[word[j] - 'a']++;
+
+    for (int letter = 0; letter < 26; letter++)
+      missing += max(0, needed[letter] - fixed[letter] - pool.counts['a' + letter]);
+
+    if (missing <= pool.blanks)
+      foundWordPositions[kept++] = foundWordPositions[i];
+  }
+
+  foundWordPositions.resize(kept);
+}
@@ -0,0 +1,96 @@
+/*******************************************************************************
+Title:         pattern_index.h
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   An index of which words have which letter at which position,
+               kept as one bitmap per length, position and letter.
+Purpose:       Answers crossword style patterns like c?t* by combining a few
+               bitmaps 64 words at a time, instead of reading every word.
+Usage:         ./findwords --patterns dictionaryfile.txt
+               then c?t* or ??r????, and add /aeiou after a pattern to
+               fill its gaps from a pool of letters.
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+
+#ifndef PATTERN_INDEX_H
+#define PATTERN_INDEX_H
+
+#include "dictionary.h"
+
+// Stands for any run of letters in a pattern, even an empty one. A BLANK
+// stands for exactly one letter.
+const char ANY_LETTERS = '*';
+
+// Separates a pattern from the pool of letters that fill its gaps.
+const char POOL_SEPARATOR = '/';
+
+class PatternIndex {
+private:
+  vector<int> wordPositions;    // Dictionary positions, grouped by length.
+  vector<int> lengthStart;      // Where each length's words start in
+                                // wordPositions, one past the end last.
+  vector<unsigned long long> bitmaps; // For each length, position and letter,
+                                      // a bit for each word of that length.
+  vector<long long> bitmapStart;      // Where each length's bitmaps start.
+
+  // Returns the number of 64 bit words in each bitmap of a length.
+  int bitmapWords(int length) const;
+
+  // Returns the bitmap of the words of a length with letter at position.
+  const unsigned long long* bitmap(int length, int position, int letter) const;
+
+public:
+  // Default constructor, an empty index.
+  PatternIndex();
+
+  // Indexes every word of the dictionary by its length and letters.
+  //
+  // Precondition:  A dictionary exists, it doesn't need to be sorted.
+  // Postcondition: Every word made of the letters a to z and at least
+  //                MIN_WORD_LENGTH long is in the index, repeated words
+  //                only once.
+  //
+  // @vector<string>& dictionary:       a populated list of words.
+  void build(const vector<string>& dictionary);
+
+  // Finds all words matching a pattern. The letters before the first * and
+  // after the last * are looked up in the bitmaps, anything between them is
+  // checked on the words that are left.
+  //
+  // Precondition:  The index was built from dictionary.
+  // Postcondition: The positions of the matching words have been added,
+  //                shortest words first.
+  // return:        false if the pattern has something besides letters, ? and *.
+  //
+  // @vector<string>& dictionary:       the words the index was built from.
+  // @string& pattern:                  letters, ? for one letter and * for any.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  bool findWords(const vector<string>& dictionary, const string& pattern,
+                 vector<int>& foundWordPositions) const;
+
+  // Returns the number of words in the index.
+  int size() const;
+
+  // Returns the bytes the bitmaps use.
+  size_t memoryUsed() const;
+};
+
+
+// Drops the words whose letters besides the pattern's own can't be made
+// out of a pool of letters. Blanks in the pool stand for any letter.
+//
+// Precondition:  Every word matches pattern.
+// Postcondition: Only the words the pool can fill remain.
+//
+// @vector<string>& dictionary:       a populated list of words.
+// @string& pattern:                  the pattern the words matched.
+// @string& letters:                  the pool of letters.
+// @vector<int>& foundWordPositions:  the positions of the words.
+void keepFillable(const vector<string>& dictionary, const string& pattern,
+                  const string& letters, vector<int>& foundWordPositions);
+
+#endif
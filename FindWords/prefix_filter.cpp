@@ -0,0 +1,138 @@
+/*******************************************************************************
+Title:         prefix_filter.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   A Bloom filter of every prefix of the dictionary's words up to
+               a length, with each prefix's bits in one 64 bit word.
+Purpose:       Most prefixes the legacy search tries start no word, and each
+               of them costs a scan of the whole dictionary. The filter turns
+               almost all of them away with one memory access.
+Usage:         ./findwords dictionaryfile.txt
+               The filter's statistics are shown on exit.
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+#include "prefix_filter.h"
+
+// ***** Helpers *****
+
+// The bits set in a prefix's block.
+const int BITS_PER_PREFIX = 4;
+
+// Mixes the letters of a prefix into 64 bits: FNV-1a, then a final mix so
+// prefixes that differ only in their last letter land far apart.
+static unsigned long long hashPrefix(string_view prefix) {
+  unsigned long long hash = 14695981039346656037ULL;
+
+  for (int i = 0; i < prefix.length(); i++) {
+    hash ^= (unsigned char)prefix[i];
+    hash *= 1099511628211ULL;
+  }
+
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Returns the bits of a prefix within its block, six bits of the hash each.
+// The low bits of the hash pick the block.
+static unsigned long long prefixBits(unsigned long long hash) {
+  unsigned long long bits = 0;
+
+  for (int i = 0; i < BITS_PER_PREFIX; i++)
+    bits |= 1ULL << ((hash >> (40 + 6 * i)) & 63);
+  return bits;
+}
+
+// ***** Function Definitions *****
+
+// Default constructor, an empty filter that lets every prefix through.
+PrefixFilter::PrefixFilter() : probes(0), rejections(0), falsePositives(0) {
+  maxLength = 0;
+}
+
+// Puts every prefix of every word up to a length in the filter.
+void PrefixFilter::build(const vector<string>& dictionary, int length) {
+  long long prefixCount = 0;  // At most this many different prefixes.
+  size_t blockCount = 1;
+
+  for (int i = 0; i < dictionary.size(); i++)
+    prefixCount += min((int)dictionary[i].length(), length);
+
+  // A power of two of blocks, so a mask picks one.
+  while (blockCount * 64 < prefixCount * PREFIX_FILTER_BITS)
+    blockCount *= 2;
+
+  maxLength = length;
+  blocks.assign(blockCount, 0);
+  probes = 0;
+  rejections = 0;
+  falsePositives = 0;
+
+  for (int i = 0; i < dictionary.size(); i++) {
+    string_view word = dictionary[i];
+
+    for (int j = 1; j <= word.length() && j <= length; j++) {
+      unsigned long long hash = hashPrefix(word.substr(0, j));
+      blocks[hash & (blockCount - 1)] |= prefixBits(hash);
+    }
+  }
+}
+
+// Checks if a prefix may start a word, and counts it.
+bool PrefixFilter::mayStartWord(string_view prefix) const {
+  if (blocks.empty() || prefix.length() > maxLength)
+    return true;
+
+  unsigned long long hash = hashPrefix(prefix),
+                     bits = prefixBits(hash);
+
+  probes.fetch_add(1, memory_order_relaxed);
+  if ((blocks[hash & (blocks.size() - 1)] & bits) != bits) {
+    rejections.fetch_add(1, memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+// Counts a prefix that was let through but starts no word.
+void PrefixFilter::countFalsePositive(string_view prefix) const {
+  if (!blocks.empty() && prefix.length() <= maxLength)
+    falsePositives.fetch_add(1, memory_order_relaxed);
+}
+
+// Returns the number of prefixes checked.
+long long PrefixFilter::probeCount() const {
+  return probes;
+}
+
+// Returns the number of prefixes turned away.
+long long PrefixFilter::rejectionCount() const {
+  return rejections;
+}
+
+// Returns the number of prefixes let through that start no word.
+long long PrefixFilter::falsePositiveCount() const {
+  return falsePositives;
+}
+
+// Returns the part of the prefixes checked that were turned away.
+double PrefixFilter::rejectionRatio() const {
+  return probes == 0 ? 0 : (double)rejections / probes;
+}
+
+// Returns the part of the prefixes that start no word which were let
+// through anyway. Every prefix turned away starts no word.
+double PrefixFilter::falsePositiveRate() const {
+  long long absent = rejections + falsePositives;
+  return absent == 0 ? 0 : (double)falsePositives / absent;
+}
+
+// Returns the bytes the bits use.
+size_t PrefixFilter::memoryUsed() const {
+  return blocks.capacity() * sizeof(unsigned long long);
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************
+Title:         prefix_filter.h
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   A Bloom filter of every prefix of the dictionary's words up to
+               a length, with each prefix's bits in one 64 bit word.
+Purpose:       Most prefixes the legacy search tries start no word, and each
+               of them costs a scan of the whole dictionary. The filter turns
+               almost all of them away with one memory access.
+Usage:         ./findwords dictionaryfile.txt
+               The filter's statistics are shown on exit.
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+
+#ifndef PREFIX_FILTER_H
+#define PREFIX_FILTER_H
+
+#include <atomic>
+#include "dictionary.h"
+
+// The longest prefixes put in the filter. Longer ones are always looked up,
+// but their first PREFIX_FILTER_LENGTH letters were checked on the way.
+const int PREFIX_FILTER_LENGTH = 16;
+
+// The bits of the filter for each prefix put in it.
+const int PREFIX_FILTER_BITS = 16;
+
+class PrefixFilter {
+private:
+  vector<unsigned long long> blocks; // The bits, a prefix's all in one block.
+  int maxLength;                     // The longest prefixes put in.
+  mutable atomic<long long> probes,         // Prefixes checked.
+                            rejections,     // Prefixes turned away.
+                            falsePositives; // Prefixes let through that
+                                            // start no word.
+
+  // Not copyable, the counts are atomic.
+  PrefixFilter(const PrefixFilter&);
+  PrefixFilter& operator=(const PrefixFilter&);
+
+public:
+  // Default constructor, an empty filter that lets every prefix through.
+  PrefixFilter();
+
+  // Puts every prefix of every word up to a length in the filter.
+  //
+  // Precondition:  A dictionary exists, it doesn't need to be sorted.
+  // Postcondition: mayStartWord is true for every prefix of a word, and the
+  //                counts are zero.
+  //
+  // @vector<string>& dictionary:       a populated list of words.
+  // @int length:                       the longest prefixes put in.
+  void build(const vector<string>& dictionary, int length);
+
+  // Checks if a prefix may start a word, and counts it. A prefix longer
+  // than the filter's always may.
+  //
+  // Precondition:  None.
+  // Postcondition: The prefix has been counted, and counted as turned away
+  //                if it was.
+  // return:        false only if no word starts with prefix.
+  //
+  // @string_view prefix:               the prefix to check.
+  bool mayStartWord(string_view prefix) const;
+
+  // Counts a prefix that was let through but starts no word.
+  //
+  // Precondition:  mayStartWord(prefix) was true.
+  // Postcondition: The prefix is counted if the filter checked it.
+  //
+  // @string_view prefix:               the prefix that starts no word.
+  void countFalsePositive(string_view prefix) const;
+
+  // Returns the number of prefixes checked.
+  long long probeCount() const;
+
+  // Returns the number of prefixes turned away.
+  long long rejectionCount() const;
+
+  // Returns the number of prefixes let through that start no word.
+  long long falsePositiveCount() const;
+
+  // Returns the part of the prefixes checked that were turned away.
+  double rejectionRatio() const;
+
+  // Returns the part of the prefixes that start no word which were let
+  // through anyway.
+  double falsePositiveRate() const;
+
+  // Returns the bytes the bits use.
+  size_t memoryUsed() const;
+};
+
+#endif
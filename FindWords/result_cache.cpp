@@ -0,0 +1,119 @@
+/*******************************************************************************
+Title:         result_cache.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Remembers the words found for recent queries, forgetting the
+               least recently used ones once a memory budget is used up.
+Purpose:       The words found only depend on which letters were given, not
+               their order, so "stop", "pots" and "tops" share one answer.
+Usage:         ./findwords --cache MB dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+#include "result_cache.h"
+
+// ***** Helpers *****
+
+// Bytes an entry uses besides its key and positions: the list node, the
+// index's node and its bucket.
+const size_t ENTRY_OVERHEAD = sizeof(CacheEntry) + 4 * sizeof(void*) +
+                              sizeof(string) + sizeof(list<CacheEntry>::iterator);
+
+// Returns the bytes one entry uses.
+static size_t entrySize(const string& key, const vector<int>& foundWordPositions) {
+  // The key is stored twice, once in the entry and once in the index.
+  return ENTRY_OVERHEAD + 2 * key.length() +
+         foundWordPositions.size() * sizeof(int);
+}
+
+// ***** Function Definitions *****
+
+// Creates an empty cache.
+ResultCache::ResultCache(size_t budgetBytes) {
+  budget = budgetBytes;
+  used = 0;
+  hits = 0;
+  misses = 0;
+}
+
+// Looks up the answer for a key, and counts a hit or a miss.
+bool ResultCache::find(const string& key, vector<int>& foundWordPositions) {
+  lock_guard<mutex> guard(lock);
+  unordered_map<string, list<CacheEntry>::iterator>::iterator found =
+      index.find(key);
+
+  if (found == index.end()) {
+    misses++;
+    return false;
+  }
+
+  // Move the entry to the front, it is now the most recently used.
+  entries.splice(entries.begin(), entries, found->second);
+  foundWordPositions = found->second->foundWordPositions;
+  hits++;
+  return true;
+}
+
+// Remembers the answer for a key.
+void ResultCache::insert(const string& key, const vector<int>& foundWordPositions) {
+  lock_guard<mutex> guard(lock);
+  CacheEntry entry;
+  size_t size;
+
+  // Another thread may have searched for the same letters at the same time.
+  if (index.find(key) != index.end())
+    return;
+
+  entry.key = key;
+  entry.foundWordPositions = foundWordPositions;
+  size = entrySize(entry.key, entry.foundWordPositions);
+
+  if (size > budget)
+    return;
+
+  // Forget the least recently used answers until the new one fits.
+  while (used + size > budget && !entries.empty()) {
+    CacheEntry& oldest = entries.back();
+    used -= entrySize(oldest.key, oldest.foundWordPositions);
+    index.erase(oldest.key);
+    entries.pop_back();
+  }
+
+  entries.push_front(entry);
+  index[key] = entries.begin();
+  used += size;
+}
+
+// Returns the number of queries answered from the cache.
+long long ResultCache::hitCount() const {
+  lock_guard<mutex> guard(lock);
+  return hits;
+}
+
+// Returns the number of queries that had to be searched.
+long long ResultCache::missCount() const {
+  lock_guard<mutex> guard(lock);
+  return misses;
+}
+
+// Returns the number of remembered answers.
+int ResultCache::size() const {
+  lock_guard<mutex> guard(lock);
+  return entries.size();
+}
+
+// Returns the bytes the remembered answers use.
+size_t ResultCache::memoryUsed() const {
+  lock_guard<mutex> guard(lock);
+  return used;
+}
+
+// Returns the cache key of a query: its letters in alphabetical order.
+string cacheKey(const string& letters) {
+  string key = letters;
+  sort(key.begin(), key.end());
+  return key;
+}
@@ -0,0 +1,94 @@
+/*******************************************************************************
+Title:         result_cache.h
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Remembers the words found for recent queries, forgetting the
+               least recently used ones once a memory budget is used up.
+Purpose:       The words found only depend on which letters were given, not
+               their order, so "stop", "pots" and "tops" share one answer.
+Usage:         ./findwords --cache MB dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "dictionary.h"
+
+// One remembered answer.
+struct CacheEntry {
+  string key;                     // The sorted letters of the query.
+  vector<int> foundWordPositions; // The positions of the words found.
+};
+
+class ResultCache {
+private:
+  list<CacheEntry> entries;       // Most recently used first.
+  unordered_map<string, list<CacheEntry>::iterator> index; // Key to entry.
+  size_t budget;                  // Bytes the entries may use.
+  size_t used;                    // Bytes the entries use now.
+  long long hits,                 // Queries answered from the cache.
+            misses;               // Queries that had to be searched.
+  mutable mutex lock;             // Lets many threads share the cache.
+
+  // Not copyable, index points into entries.
+  ResultCache(const ResultCache&);
+  ResultCache& operator=(const ResultCache&);
+
+public:
+  // Creates an empty cache.
+  //
+  // @size_t budgetBytes:               the bytes the entries may use.
+  ResultCache(size_t budgetBytes);
+
+  // Looks up the answer for a key, and counts a hit or a miss.
+  //
+  // Precondition:  None.
+  // Postcondition: The entry is the most recently used if it was found.
+  // return:        true if foundWordPositions was filled from the cache.
+  //
+  // @string& key:                      the sorted letters of the query.
+  // @vector<int>& foundWordPositions:  filled with the remembered positions.
+  bool find(const string& key, vector<int>& foundWordPositions);
+
+  // Remembers the answer for a key, forgetting the least recently used
+  // answers until it fits in the budget.
+  //
+  // Precondition:  None.
+  // Postcondition: The answer is remembered unless it is larger than the
+  //                whole budget.
+  //
+  // @string& key:                      the sorted letters of the query.
+  // @vector<int>& foundWordPositions:  the positions of the words found.
+  void insert(const string& key, const vector<int>& foundWordPositions);
+
+  // Returns the number of queries answered from the cache.
+  long long hitCount() const;
+
+  // Returns the number of queries that had to be searched.
+  long long missCount() const;
+
+  // Returns the number of remembered answers.
+  int size() const;
+
+  // Returns the bytes the remembered answers use.
+  size_t memoryUsed() const;
+};
+
+
+// Returns the cache key of a query: its letters in alphabetical order.
+//
+// Precondition:  letters is lowercase.
+// Postcondition: None.
+//
+// @string& letters:                 the letters of the user's word.
+string cacheKey(const string& letters);
+
+#endif
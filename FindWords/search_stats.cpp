@@ -0,0 +1,92 @@
+/*******************************************************************************
+Title:         search_stats.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Counts what a search does for one query: the prefixes it
+               follows, the lookups it makes and how many of them find
+               something, the longest prefix and the time it takes.
+Purpose:       Shows where a search spends its time on a bad query, so slow
+               queries can be found in the logs and the right search picked.
+Usage:         ./findwords --stats [other options] dictionaryfile.txt
+               Each query's counts are shown on the error stream, and the
+               totals on exit.
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+#include "search_stats.h"
+
+// ***** Helpers *****
+
+// Shows a set of counts after a label, all on one line.
+static void printCounts(ostream& output, const SearchStats& stats) {
+  output << stats.nodesVisited << " nodes, "
+         << stats.probes << " probes, "
+         << stats.probeHits << " found, "
+         << "deepest prefix " << stats.deepestPrefix << ", "
+         << stats.wordsFound << " words, "
+         << (long long)(stats.seconds * 1e6) << " us";
+}
+
+// ***** Function Definitions *****
+
+thread_local SearchStats* queryStats = NULL;
+
+// Sets every count to zero.
+void clearStats(SearchStats& stats) {
+  stats.nodesVisited = 0;
+  stats.probes = 0;
+  stats.probeHits = 0;
+  stats.deepestPrefix = 0;
+  stats.wordsFound = 0;
+  stats.seconds = 0;
+}
+
+// Adds one set of counts to another.
+void addStats(SearchStats& total, const SearchStats& more) {
+  total.nodesVisited += more.nodesVisited;
+  total.probes += more.probes;
+  total.probeHits += more.probeHits;
+  total.deepestPrefix = max(total.deepestPrefix, more.deepestPrefix);
+  total.wordsFound += more.wordsFound;
+  total.seconds += more.seconds;
+}
+
+// Creates an empty log.
+SearchLog::SearchLog(ostream& output) {
+  outputStream = &output;
+  clearStats(totals);
+  queries = 0;
+  slowestSeconds = -1;
+}
+
+// Shows a query's counts on one line and adds them to the totals.
+void SearchLog::record(const string& query, const SearchStats& stats) {
+  lock_guard<mutex> guard(lock);
+
+  *outputStream << "Stats: " << query << ": ";
+  printCounts(*outputStream, stats);
+  *outputStream << endl;
+
+  addStats(totals, stats);
+  queries++;
+  if (stats.seconds > slowestSeconds) {
+    slowestQuery = query;
+    slowestSeconds = stats.seconds;
+  }
+}
+
+// Shows the totals of every query recorded.
+void SearchLog::printSummary() const {
+  lock_guard<mutex> guard(lock);
+
+  *outputStream << "Stats total: " << queries << " queries, ";
+  printCounts(*outputStream, totals);
+  if (queries > 0)
+    *outputStream << ", " << (long long)(totals.seconds * 1e6 / queries)
+                  << " us per query, slowest " << slowestQuery << " in "
+                  << (long long)(slowestSeconds * 1e6) << " us";
+  *outputStream << endl;
+}
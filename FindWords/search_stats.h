@@ -0,0 +1,127 @@
+/*******************************************************************************
+Title:         search_stats.h
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Counts what a search does for one query: the prefixes it
+               follows, the lookups it makes and how many of them find
+               something, the longest prefix and the time it takes.
+Purpose:       Shows where a search spends its time on a bad query, so slow
+               queries can be found in the logs and the right search picked.
+Usage:         ./findwords --stats [other options] dictionaryfile.txt
+               Each query's counts are shown on the error stream, and the
+               totals on exit.
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H
+
+#include <mutex>
+#include "dictionary.h"
+
+// What a search did for one query, or for many added together.
+struct SearchStats {
+  long long nodesVisited;   // Prefixes followed, one per step of the search.
+  long long probes;         // Lookups of a prefix, a letter or a word.
+  long long probeHits;      // Lookups that found something.
+  int deepestPrefix;        // The longest prefix followed.
+  long long wordsFound;     // Words in the answer.
+  double seconds;           // Time taken.
+};
+
+// The counts of the query this thread is searching for, or NULL when
+// nothing is being counted. Each thread has its own.
+extern thread_local SearchStats* queryStats;
+
+// Counts a prefix the search follows.
+//
+// Precondition:  None.
+// Postcondition: The prefix is counted if this thread is counting.
+//
+// @int depth:                        the length of the prefix.
+inline void countNode(int depth) {
+  SearchStats* stats = queryStats;
+
+  if (stats != NULL) {
+    stats->nodesVisited++;
+    if (depth > stats->deepestPrefix)
+      stats->deepestPrefix = depth;
+  }
+}
+
+// Counts lookups and how many of them found something.
+//
+// Precondition:  None.
+// Postcondition: The lookups are counted if this thread is counting.
+//
+// @long long probes:                 the number of lookups.
+// @long long hits:                   the number that found something.
+inline void countProbes(long long probes, long long hits) {
+  SearchStats* stats = queryStats;
+
+  if (stats != NULL) {
+    stats->probes += probes;
+    stats->probeHits += hits;
+  }
+}
+
+// Sets every count to zero.
+//
+// Precondition:  None.
+// Postcondition: stats is all zeros.
+//
+// @SearchStats& stats:               the counts to clear.
+void clearStats(SearchStats& stats);
+
+// Adds one set of counts to another. The deepest prefix is the deeper one.
+//
+// Precondition:  None.
+// Postcondition: total includes more.
+//
+// @SearchStats& total:               the counts added to.
+// @SearchStats& more:                the counts to add.
+void addStats(SearchStats& total, const SearchStats& more);
+
+
+// Shows each query's counts as it is answered and keeps their totals. Many
+// threads may record at once.
+class SearchLog {
+private:
+  ostream* outputStream;    // Where the counts are shown.
+  SearchStats totals;       // Every query's counts added together.
+  long long queries;        // Queries recorded.
+  string slowestQuery;      // The query that took the longest.
+  double slowestSeconds;    // How long it took.
+  mutable mutex lock;       // Lets many threads record.
+
+  // Not copyable, it holds a lock.
+  SearchLog(const SearchLog&);
+  SearchLog& operator=(const SearchLog&);
+
+public:
+  // Creates an empty log.
+  //
+  // @ostream& output:                  where the counts are shown.
+  SearchLog(ostream& output);
+
+  // Shows a query's counts on one line and adds them to the totals.
+  //
+  // Precondition:  None.
+  // Postcondition: The query is counted.
+  //
+  // @string& query:                    the user's query.
+  // @SearchStats& stats:               what the search did for it.
+  void record(const string& query, const SearchStats& stats);
+
+  // Shows the totals of every query recorded.
+  //
+  // Precondition:  None.
+  // Postcondition: None.
+  void printSummary() const;
+};
+
+#endif
@@ -0,0 +1,397 @@
+/*******************************************************************************
+Title:         server.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Answers queries from many clients over a Unix domain socket,
+               keeping the dictionary loaded between them.
+Purpose:       Callers only pay for the search, not for loading the
+               dictionary again on every call.
+Usage:         ./findwords --server /tmp/findwords.sock [--threads N]
+                           dictionaryfile.txt
+               ./findwords_client /tmp/findwords.sock stop pots tops
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+#include "server.h"
+#include "batch.h"
+
+#include <map>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include <csignal>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// ***** Helpers *****
+
+// Set by SIGINT or SIGTERM to stop the server.
+static volatile sig_atomic_t stopServer = 0;
+
+// Stops the server when the process is interrupted.
+static void handleStop(int) {
+  stopServer = 1;
+}
+
+// One query waiting for a worker, or its answer waiting to be sent.
+struct ServerJob {
+  unsigned long long client;  // The client that sent the query.
+  long long sequence;         // Which of the client's queries it is.
+  string text;                // The query, then its answer.
+};
+
+// A connected client.
+struct ServerClient {
+  int socket;                 // The client's socket.
+  unsigned long long id;      // Never reused, unlike the socket.
+  string input;               // Bytes read that don't end a line yet.
+  string output;              // Answers that haven't been written yet.
+  long long nextSequence,     // The number of the next query read.
+            nextToSend;       // The number of the next answer to write.
+  map<long long, string> answered; // Answers that came back out of order.
+  bool doneReading;           // The client won't send more queries.
+  bool dropped;               // The client broke the protocol.
+  bool watched;               // The event loop is waiting on the socket.
+};
+
+// What the worker threads share with the event loop.
+struct ServerWork {
+  const WordFinder* finder;   // The dictionary and search.
+  queue<ServerJob> jobs;      // Queries waiting for a worker.
+  vector<ServerJob> answers;  // Answers waiting for the event loop.
+  bool finished;              // The workers should stop.
+  mutex lock;                 // Protects jobs, answers and finished.
+  condition_variable jobReady;// Signals a new job or the end.
+  int wakeUp;                 // An eventfd that tells the loop about answers.
+};
+
+// Answers queries until the server stops.
+static void serverWorker(ServerWork* work) {
+  while (true) {
+    ServerJob job;
+
+    {
+      unique_lock<mutex> guard(work->lock);
+      while (!work->finished && work->jobs.empty())
+        work->jobReady.wait(guard);
+
+      if (work->finished)
+        return;
+
+      job = work->jobs.front();
+      work->jobs.pop();
+    }
+
+    job.text = answerQuery(*work->finder, job.text);
+
+    {
+      lock_guard<mutex> guard(work->lock);
+      work->answers.push_back(job);
+    }
+
+    // Wake the event loop up, the count doesn't matter.
+    unsigned long long one = 1;
+    if (write(work->wakeUp, &one, sizeof(one)) < 0) {}
+  }
+}
+
+// Makes a file descriptor return instead of waiting.
+static bool setNonBlocking(int descriptor) {
+  int flags = fcntl(descriptor, F_GETFL, 0);
+  return flags >= 0 && fcntl(descriptor, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// Checks if a client has so many answers waiting that no more of its
+// queries should be read until it takes some of them.
+static bool backedUp(const ServerClient& client) {
+  return client.output.length() > MAX_PENDING_OUTPUT ||
+         client.nextSequence - client.nextToSend >= MAX_PENDING_QUERIES;
+}
+
+// Changes what the event loop waits for on a client: more queries until it
+// stops sending or is backed up, and room to write while answers are
+// waiting. A client with nothing to read or write isn't waited on at all,
+// otherwise a hung up socket would wake the loop over and over while its
+// queries are being answered.
+static void watchClient(int events, ServerClient& client) {
+  struct epoll_event event;
+  unsigned int wanted = 0;
+
+  if (!client.doneReading && !backedUp(client))
+    wanted |= EPOLLIN;
+  if (!client.output.empty())
+    wanted |= EPOLLOUT;
+
+  if (wanted == 0) {
+    if (client.watched)
+      epoll_ctl(events, EPOLL_CTL_DEL, client.socket, NULL);
+    client.watched = false;
+    return;
+  }
+
+  memset(&event, 0, sizeof(event));
+  event.events = wanted;
+  event.data.fd = client.socket;
+  epoll_ctl(events, client.watched ? EPOLL_CTL_MOD : EPOLL_CTL_ADD,
+            client.socket, &event);
+  client.watched = true;
+}
+
+// Writes as much of a client's answers as the socket takes.
+// Returns false if the client went away.
+static bool flushClient(ServerClient& client) {
+  while (!client.output.empty()) {
+    ssize_t written = write(client.socket, client.output.data(),
+                            client.output.size());
+    if (written < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        return true;
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    client.output.erase(0, written);
+  }
+  return true;
+}
+
+// ***** Function Definitions *****
+
+// Answers line delimited queries on a Unix domain socket.
+bool runServer(const WordFinder& finder, const string& socketPath,
+               int threadCount) {
+  map<int, ServerClient> clients;   // Connected clients by socket.
+  map<unsigned long long, int> sockets; // Sockets by client id.
+  unsigned long long nextClient = 1;
+  vector<thread> workers;
+  ServerWork work;
+  struct sockaddr_un address;
+  struct epoll_event event, ready[64];
+  sigset_t stopSignals,     // SIGINT and SIGTERM.
+           waitSignals;     // What may interrupt the wait for events.
+  int listener, events;
+
+  if (socketPath.length() >= sizeof(address.sun_path)) {
+    cerr << "ERROR! Socket path is too long: " << socketPath << endl;
+    return false;
+  }
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, socketPath.c_str());
+
+  // A socket left over from a server that didn't stop cleanly would
+  // make bind fail.
+  unlink(socketPath.c_str());
+
+  listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0 || bind(listener, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+      listen(listener, SOMAXCONN) != 0 || !setNonBlocking(listener)) {
+    cerr << "ERROR! Cannot listen on " << socketPath << endl;
+    if (listener >= 0)
+      close(listener);
+    return false;
+  }
+
+  events = epoll_create1(0);
+  work.wakeUp = eventfd(0, EFD_NONBLOCK);
+  work.finder = &finder;
+  work.finished = false;
+
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN;
+  event.data.fd = listener;
+  bool watching = events >= 0 && work.wakeUp >= 0 &&
+                  epoll_ctl(events, EPOLL_CTL_ADD, listener, &event) == 0;
+  event.data.fd = work.wakeUp;
+  if (!watching || epoll_ctl(events, EPOLL_CTL_ADD, work.wakeUp, &event) != 0) {
+    cerr << "ERROR! Cannot wait for events on " << socketPath << endl;
+    if (work.wakeUp >= 0)
+      close(work.wakeUp);
+    if (events >= 0)
+      close(events);
+    close(listener);
+    return false;
+  }
+
+  signal(SIGINT, handleStop);
+  signal(SIGTERM, handleStop);
+  signal(SIGPIPE, SIG_IGN);
+
+  // The stop signals are blocked everywhere, the workers inherit that, and
+  // only let through while the loop waits for events. So a signal always
+  // interrupts the wait, and can't land between checking stopServer and
+  // starting to wait.
+  sigemptyset(&stopSignals);
+  sigaddset(&stopSignals, SIGINT);
+  sigaddset(&stopSignals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &stopSignals, &waitSignals);
+  sigdelset(&waitSignals, SIGINT);
+  sigdelset(&waitSignals, SIGTERM);
+
+  if (threadCount < 1)
+    threadCount = 1;
+  for (int i = 0; i < threadCount; i++)
+    workers.push_back(thread(serverWorker, &work));
+
+  cerr << "Listening on " << socketPath << endl;
+
+  while (!stopServer) {
+    int count = epoll_pwait(events, ready, 64, -1, &waitSignals);
+    vector<int> touched;  // Clients whose state changed this round.
+
+    if (count < 0) {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+
+    for (int i = 0; i < count; i++) {
+      int descriptor = ready[i].data.fd;
+
+      // Accept every waiting client.
+      if (descriptor == listener) {
+        int socket;
+        while ((socket = accept(listener, NULL, NULL)) >= 0) {
+          ServerClient client;
+          setNonBlocking(socket);
+          client.socket = socket;
+          client.id = nextClient++;
+          client.nextSequence = 0;
+          client.nextToSend = 0;
+          client.doneReading = false;
+          client.dropped = false;
+          client.watched = false;
+          clients[socket] = client;
+          sockets[client.id] = socket;
+          watchClient(events, clients[socket]);
+        }
+        continue;
+      }
+
+      // Put the workers' answers in order for their clients.
+      if (descriptor == work.wakeUp) {
+        unsigned long long wakeUps;
+        vector<ServerJob> answers;
+
+        if (read(work.wakeUp, &wakeUps, sizeof(wakeUps)) < 0) {}
+        {
+          lock_guard<mutex> guard(work.lock);
+          answers.swap(work.answers);
+        }
+
+        for (int j = 0; j < answers.size(); j++) {
+          map<unsigned long long, int>::iterator found = sockets.find(answers[j].client);
+          if (found == sockets.end())
+            continue;   // The client left before its answer was ready.
+
+          ServerClient& client = clients[found->second];
+          client.answered[answers[j].sequence] = answers[j].text;
+
+          while (!client.answered.empty() &&
+                 client.answered.begin()->first == client.nextToSend) {
+            client.output += client.answered.begin()->second;
+            client.output += '\n';
+            client.answered.erase(client.answered.begin());
+            client.nextToSend++;
+          }
+          touched.push_back(client.socket);
+        }
+        continue;
+      }
+
+      if (clients.find(descriptor) == clients.end())
+        continue;
+
+      ServerClient& client = clients[descriptor];
+
+      // Read what the client sent, a buffer at a time, and queue every
+      // full line. A backed up client is read again once it takes its
+      // answers.
+      if (ready[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+        char buffer[4096];
+        ssize_t length = 1;
+
+        while (!client.doneReading && !client.dropped && !backedUp(client)) {
+          length = read(descriptor, buffer, sizeof(buffer));
+          if (length > 0)
+            client.input.append(buffer, length);
+          else if (length == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+            client.doneReading = true;
+
+          size_t end;
+          while ((end = client.input.find('\n')) != string::npos ||
+                 (client.doneReading && !client.input.empty())) {
+            string line = client.input.substr(0, end);
+            client.input.erase(0, end == string::npos ? end : end + 1);
+
+            if (!line.empty() && line[line.length()-1] == '\r')
+              line.erase(line.length()-1);
+
+            ServerJob job = {client.id, client.nextSequence++, line};
+            lock_guard<mutex> guard(work.lock);
+            work.jobs.push(job);
+            work.jobReady.notify_one();
+          }
+
+          // A line this long isn't a query, drop the client.
+          if (client.input.length() > MAX_REQUEST_LINE)
+            client.dropped = true;
+
+          if (length < 0)
+            break;
+        }
+      }
+
+      touched.push_back(descriptor);
+    }
+
+    // Write what can be written, and close the clients that are done.
+    for (int i = 0; i < touched.size(); i++) {
+      map<int, ServerClient>::iterator found = clients.find(touched[i]);
+      if (found == clients.end())
+        continue;
+
+      ServerClient& client = found->second;
+      bool alive = flushClient(client);
+      bool done = client.doneReading && client.nextToSend == client.nextSequence &&
+                  client.output.empty();
+
+      if (!alive || done || client.dropped) {
+        if (client.watched)
+          epoll_ctl(events, EPOLL_CTL_DEL, client.socket, NULL);
+        close(client.socket);
+        sockets.erase(client.id);
+        clients.erase(found);
+      } else {
+        watchClient(events, client);
+      }
+    }
+  }
+
+  {
+    lock_guard<mutex> guard(work.lock);
+    work.finished = true;
+    work.jobReady.notify_all();
+  }
+
+  for (int i = 0; i < workers.size(); i++)
+    workers[i].join();
+
+  for (map<int, ServerClient>::iterator i = clients.begin(); i != clients.end(); i++)
+    close(i->first);
+
+  close(work.wakeUp);
+  close(events);
+  close(listener);
+  unlink(socketPath.c_str());
+  return true;
+}
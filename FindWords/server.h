@@ -0,0 +1,46 @@
+/*******************************************************************************
+Title:         server.h
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Answers queries from many clients over a Unix domain socket,
+               keeping the dictionary loaded between them.
+Purpose:       Callers only pay for the search, not for loading the
+               dictionary again on every call.
+Usage:         ./findwords --server /tmp/findwords.sock [--threads N]
+                           dictionaryfile.txt
+               ./findwords_client /tmp/findwords.sock stop pots tops
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "word_finder.h"
+
+// Largest number of bytes a client may send without ending a line.
+const int MAX_REQUEST_LINE = 4096;
+
+// Answers a client may have waiting, as bytes not yet written or queries
+// not yet answered, before the server stops reading its queries.
+const size_t MAX_PENDING_OUTPUT = 1 << 20;
+const long long MAX_PENDING_QUERIES = 1024;
+
+// Answers line delimited queries on a Unix domain socket until the process
+// is interrupted. Each query line gets one line back, in the format of
+// answerQuery, in the order the client sent them.
+//
+// Precondition:  finder has loaded a dictionary.
+// Postcondition: The socket has been removed.
+// return:        false if the socket couldn't be set up.
+//
+// @WordFinder& finder:               the dictionary and search, shared by all threads.
+// @string& socketPath:               the path to listen on.
+// @int threadCount:                  the number of worker threads.
+bool runServer(const WordFinder& finder, const string& socketPath,
+               int threadCount);
+
+#endif
@@ -0,0 +1,387 @@
+/*******************************************************************************
+Title:         trie.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   A compiled trie of the dictionary, searched depth first with
+               a count of the letters left to use.
+Purpose:       Finds the same words as findWords without rebuilding strings
+               or searching the dictionary from the start for every prefix.
+Usage:         ./findwords --engine trie dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+#include "trie.h"
+#include "search_stats.h"
+
+// ***** Helpers *****
+
+// A node whose children haven't been added yet, and the range of sorted
+// words that go through it.
+struct PendingNode {
+  int node,   // Position of the node in the node list.
+      lo,     // First word of the range.
+      hi,     // One past the last word of the range.
+      depth;  // Length of the prefix leading to the node.
+};
+
+// The state of one search for the best words.
+struct BestSearch {
+  const ScoreTable* table;    // The scores.
+  const vector<int>* bounds;  // The best score below each node.
+  int count;                  // The number of words wanted.
+  int exactLength;            // The length every word must be, 0 for any.
+  vector<ScoredWord> kept;    // The best words so far, a heap with the
+                              // worst of them on top.
+};
+
+// ***** Function Definitions *****
+
+// Default constructor, an empty trie.
+Trie::Trie() {
+  attachedNodes = NULL;
+  attachedCount = 0;
+}
+
+// Compiles a dictionary into the trie.
+void Trie::build(const vector<string>& dictionary) {
+  vector<int> order(dictionary.size()); // Positions of the words, sorted.
+  vector<PendingNode> pending;          // Nodes waiting for their children.
+  ByWordAt byWord;
+
+  for (int i = 0; i < order.size(); i++)
+    order[i] = i;
+
+  // Sorting puts all words with the same prefix next to each other. A stable
+  // sort keeps the first copy of a repeated word first.
+  byWord.dictionary = &dictionary;
+  stable_sort(order.begin(), order.end(), byWord);
+
+  TrieNode root = {0, -1, 0, 0};
+  PendingNode all = {0, 0, (int)order.size(), 0};
+  attachedNodes = NULL;
+  attachedCount = 0;
+  nodes.clear();
+  nodes.push_back(root);
+  pending.push_back(all);
+
+  // Handle the nodes in the order they were made, so that every node's
+  // children end up next to each other.
+  for (int i = 0; i < pending.size(); i++) {
+    PendingNode current = pending[i];
+    int lo = current.lo;
+
+    // The word ending at this node sorts before all longer words.
+    while (lo < current.hi && dictionary[order[lo]].length() == current.depth) {
+      if (nodes[current.node].wordPosition == -1)
+        nodes[current.node].wordPosition = order[lo];
+      lo++;
+    }
+
+    nodes[current.node].firstChild = nodes.size();
+
+    // Every different next letter in the range is a child.
+    while (lo < current.hi) {
+      char letter = dictionary[order[lo]][current.depth];
+      int hi = lo;
+
+      while (hi < current.hi && dictionary[order[hi]][current.depth] == letter)
+        hi++;
+
+      TrieNode child = {0, -1, letter, 0};
+      PendingNode next = {(int)nodes.size(), lo, hi, current.depth + 1};
+      nodes.push_back(child);
+      pending.push_back(next);
+      nodes[current.node].childCount++;
+
+      lo = hi;
+    }
+  }
+}
+
+// Searches a node list that was compiled ahead of time instead.
+void Trie::attach(const TrieNode* compiledNodes, int count) {
+  nodes.clear();
+  attachedNodes = compiledNodes;
+  attachedCount = count;
+}
+
+// Returns the nodes of the trie, breadth first, the root first.
+const TrieNode* Trie::data() const {
+  return nodeList();
+}
+
+// Returns the node list being searched, built or attached.
+const TrieNode* Trie::nodeList() const {
+  if (attachedNodes != NULL)
+    return attachedNodes;
+  return nodes.empty() ? NULL : &nodes[0];
+}
+
+// Finds all words in the dictionary that can be made out of letters.
+void Trie::findWords(const string& letters, vector<int>& foundWordPositions) const {
+  int letterCounts[26] = {0}; // How many of each letter can still be used.
+
+  if (size() == 0)
+    return;
+
+  // Only the letters a to z are in the trie's search.
+  for (int i = 0; i < letters.length(); i++) {
+    if (letters[i] >= 'a' && letters[i] <= 'z')
+      letterCounts[letters[i] - 'a']++;
+  }
+
+  search(nodeList(), 0, letterCounts, countBlanks(letters), 0,
+         foundWordPositions);
+}
+
+// Splits a search into tasks that can run on different threads.
+void Trie::splitSearch(const string& letters, int splitDepth,
+                       vector<TrieTask>& tasks,
+                       vector<int>& foundWordPositions) const {
+  int letterCounts[26] = {0}; // How many of each letter can still be used.
+
+  if (size() == 0)
+    return;
+
+  for (int i = 0; i < letters.length(); i++) {
+    if (letters[i] >= 'a' && letters[i] <= 'z')
+      letterCounts[letters[i] - 'a']++;
+  }
+
+  split(nodeList(), 0, letterCounts, countBlanks(letters), 0, splitDepth,
+        tasks, foundWordPositions);
+}
+
+// Finds the words below the node of a task.
+void Trie::runTask(const TrieTask& task, vector<int>& foundWordPositions) const {
+  int letterCounts[26];   // The task's own copy of the letters left.
+
+  memcpy(letterCounts, task.letterCounts, sizeof(letterCounts));
+  search(nodeList(), task.node, letterCounts, task.blanks, task.depth,
+         foundWordPositions);
+}
+
+// Follows every prefix that can be made down to splitDepth.
+void Trie::split(const TrieNode* list, int node, int letterCounts[], int blanks,
+                 int depth, int splitDepth, vector<TrieTask>& tasks,
+                 vector<int>& foundWordPositions) const {
+  int first = list[node].firstChild,
+      last  = first + list[node].childCount;
+
+  countNode(depth);
+
+  for (int i = first; i < last; i++) {
+    int letter = list[i].letter - 'a';
+
+    if (letter < 0 || letter >= 26)
+      continue;
+
+    bool blank = letterCounts[letter] == 0;
+    countProbes(1, !blank || blanks > 0);
+    if (blank && blanks == 0)
+      continue;
+
+    if (blank)
+      blanks--;
+    else
+      letterCounts[letter]--;
+
+    if (list[i].wordPosition != -1 && depth + 1 >= MIN_WORD_LENGTH)
+      foundWordPositions.push_back(list[i].wordPosition);
+
+    // Deep enough, the rest of this prefix is somebody else's work.
+    if (depth + 1 >= splitDepth) {
+      TrieTask task;
+      task.node = i;
+      task.depth = depth + 1;
+      task.blanks = blanks;
+      memcpy(task.letterCounts, letterCounts, sizeof(task.letterCounts));
+      tasks.push_back(task);
+    } else {
+      split(list, i, letterCounts, blanks, depth + 1, splitDepth, tasks,
+            foundWordPositions);
+    }
+
+    if (blank)
+      blanks++;
+    else
+      letterCounts[letter]++;
+  }
+}
+
+// Finds all words below a node that can be made with the letters left.
+void Trie::search(const TrieNode* list, int node, int letterCounts[], int blanks,
+                  int depth, vector<int>& foundWordPositions) const {
+  int first = list[node].firstChild,
+      last  = first + list[node].childCount;
+
+  countNode(depth);
+
+  for (int i = first; i < last; i++) {
+    int letter = list[i].letter - 'a';
+
+    if (letter < 0 || letter >= 26)
+      continue;
+
+    // Skip children we have neither the letter nor a blank for. A blank is
+    // only used once the letter runs out, using it sooner would find the
+    // same words again.
+    bool blank = letterCounts[letter] == 0;
+    countProbes(1, !blank || blanks > 0);
+    if (blank && blanks == 0)
+      continue;
+
+    // Use the letter, look for words below, and then give it back.
+    if (blank)
+      blanks--;
+    else
+      letterCounts[letter]--;
+
+    if (list[i].wordPosition != -1 && depth + 1 >= MIN_WORD_LENGTH)
+      foundWordPositions.push_back(list[i].wordPosition);
+
+    search(list, i, letterCounts, blanks, depth + 1, foundWordPositions);
+
+    if (blank)
+      blanks++;
+    else
+      letterCounts[letter]++;
+  }
+}
+
+// Finds the best score of any word below each node.
+void Trie::scoreBounds(const ScoreTable& table, vector<int>& bounds) const {
+  bounds.assign(size(), -1);
+
+  if (size() > 0)
+    bound(nodeList(), 0, 0, 0, table, bounds);
+}
+
+// Finds the best score of any word below a node.
+int Trie::bound(const TrieNode* list, int node, int depth, int prefixScore,
+                const ScoreTable& table, vector<int>& bounds) const {
+  int first = list[node].firstChild,
+      last  = first + list[node].childCount,
+      best  = -1;
+
+  if (list[node].wordPosition != -1 && depth >= MIN_WORD_LENGTH)
+    best = prefixScore + lengthBonus(table, depth);
+
+  for (int i = first; i < last; i++) {
+    int letter = list[i].letter - 'a';
+
+    // Only the letters a to z can be searched for.
+    if (letter < 0 || letter >= 26)
+      continue;
+
+    best = max(best, bound(list, i, depth + 1,
+                           prefixScore + table.letterScores[letter],
+                           table, bounds));
+  }
+
+  bounds[node] = best;
+  return best;
+}
+
+// Finds the count best scoring words that can be made out of letters.
+void Trie::findBest(const string& letters, const ScoreTable& table,
+                    const vector<int>& bounds, int count, int exactLength,
+                    vector<ScoredWord>& best) const {
+  int letterCounts[26] = {0}; // How many of each letter can still be used.
+  BestSearch search;
+
+  best.clear();
+  if (size() == 0 || count <= 0)
+    return;
+
+  for (int i = 0; i < letters.length(); i++) {
+    if (letters[i] >= 'a' && letters[i] <= 'z')
+      letterCounts[letters[i] - 'a']++;
+  }
+
+  search.table = &table;
+  search.bounds = &bounds;
+  search.count = count;
+  search.exactLength = exactLength;
+
+  searchBest(nodeList(), 0, letterCounts, countBlanks(letters), 0, 0, search);
+
+  // Turning the heap into a sorted list puts the best word first.
+  sort_heap(search.kept.begin(), search.kept.end(), ranksBefore);
+  best.swap(search.kept);
+}
+
+// Finds the best words below a node that can be made with the letters left.
+void Trie::searchBest(const TrieNode* list, int node, int letterCounts[],
+                      int blanks, int depth, int prefixScore,
+                      BestSearch& search) const {
+  int first = list[node].firstChild,
+      last  = first + list[node].childCount;
+
+  countNode(depth);
+  vector<ScoredWord>& kept = search.kept;
+
+  for (int i = first; i < last; i++) {
+    int letter = list[i].letter - 'a';
+
+    if (letter < 0 || letter >= 26)
+      continue;
+
+    bool blank = letterCounts[letter] == 0;
+    countProbes(1, !blank || blanks > 0);
+    if (blank && blanks == 0)
+      continue;
+
+    // Nothing below can beat the worst word kept. A word with the same
+    // score still could, if it comes earlier in the dictionary.
+    if (kept.size() == search.count && (*search.bounds)[i] < kept.front().score)
+      continue;
+
+    // A letter from a blank is worth nothing.
+    int score = prefixScore + (blank ? 0 : search.table->letterScores[letter]);
+
+    if (blank)
+      blanks--;
+    else
+      letterCounts[letter]--;
+
+    if (list[i].wordPosition != -1 && depth + 1 >= MIN_WORD_LENGTH &&
+        (search.exactLength == 0 || depth + 1 == search.exactLength)) {
+      ScoredWord word = {list[i].wordPosition,
+                         score + lengthBonus(*search.table, depth + 1)};
+
+      if (kept.size() < search.count) {
+        kept.push_back(word);
+        push_heap(kept.begin(), kept.end(), ranksBefore);
+      } else if (ranksBefore(word, kept.front())) {
+        pop_heap(kept.begin(), kept.end(), ranksBefore);
+        kept.back() = word;
+        push_heap(kept.begin(), kept.end(), ranksBefore);
+      }
+    }
+
+    // With an exact length, nothing deeper can be used.
+    if (search.exactLength == 0 || depth + 1 < search.exactLength)
+      searchBest(list, i, letterCounts, blanks, depth + 1, score, search);
+
+    if (blank)
+      blanks++;
+    else
+      letterCounts[letter]++;
+  }
+}
+
+// Returns the number of nodes in the trie.
+int Trie::size() const {
+  if (attachedNodes != NULL)
+    return attachedCount;
+  return nodes.size();
+}
+
+// Returns the bytes the built nodes use.
+size_t Trie::memoryUsed() const {
+  return nodes.capacity() * sizeof(TrieNode);
+}
@@ -0,0 +1,209 @@
+/*******************************************************************************
+Title:         trie.h
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   A compiled trie of the dictionary, searched depth first with
+               a count of the letters left to use.
+Purpose:       Finds the same words as findWords without rebuilding strings
+               or searching the dictionary from the start for every prefix.
+Usage:         ./findwords --engine trie dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+
+#ifndef TRIE_H
+#define TRIE_H
+
+#include "dictionary.h"
+#include "word_score.h"
+
+// One letter of the trie. The children of a node are stored next to each
+// other, in alphabetical order, so a node only needs to know where they start.
+struct TrieNode {
+  int firstChild;           // Position of the first child in the node list.
+  int wordPosition;         // Position in the dictionary of the word ending
+                            // here, or -1 if no word ends here.
+  char letter;              // The letter leading to this node.
+  short childCount;         // Number of children of this node.
+};
+
+// The part of a search below one node, which can run apart from the rest.
+struct TrieTask {
+  int node;             // The node the task's prefix ends at.
+  int depth;            // The length of the prefix.
+  int letterCounts[26]; // How many of each letter are left after the prefix.
+  int blanks;           // How many blanks are left after the prefix.
+};
+
+// The state of one search for the best words.
+struct BestSearch;
+
+class Trie {
+private:
+  vector<TrieNode> nodes;   // Every node, breadth first, the root first.
+  const TrieNode* attachedNodes; // Nodes compiled ahead of time, used instead
+  int attachedCount;             // of nodes when not NULL.
+
+  // Returns the node list being searched, built or attached.
+  const TrieNode* nodeList() const;
+
+  // Finds all words below a node that can be made with the letters left.
+  // A blank is only used for a child whose letter has run out.
+  //
+  // Precondition:  The trie has been built.
+  // Postcondition: All words below node that can be made have been found.
+  //
+  // @TrieNode* list:                   the node list being searched.
+  // @int node:                         the node the prefix ends at.
+  // @int letterCounts[]:               how many of each letter are left.
+  // @int blanks:                       how many blanks are left.
+  // @int depth:                        the length of the prefix.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void search(const TrieNode* list, int node, int letterCounts[], int blanks,
+              int depth, vector<int>& foundWordPositions) const;
+
+  // Follows every prefix that can be made down to splitDepth, and makes a
+  // task for the words below each of them.
+  //
+  // Precondition:  The trie has been built.
+  // Postcondition: Words shorter than splitDepth have been found, and every
+  //                node at splitDepth that can be reached has a task.
+  //
+  // @TrieNode* list:                   the node list being searched.
+  // @int node:                         the node the prefix ends at.
+  // @int letterCounts[]:               how many of each letter are left.
+  // @int blanks:                       how many blanks are left.
+  // @int depth:                        the length of the prefix.
+  // @int splitDepth:                   the length of the tasks' prefixes.
+  // @vector<TrieTask>& tasks:          a list of the tasks made.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void split(const TrieNode* list, int node, int letterCounts[], int blanks,
+             int depth, int splitDepth, vector<TrieTask>& tasks,
+             vector<int>& foundWordPositions) const;
+
+  // Finds the best score of any word below a node, and of the words below
+  // each of its children.
+  //
+  // Precondition:  bounds has a slot for every node.
+  // Postcondition: bounds holds the best score below node and its children.
+  // return:        the best score below node, or -1 if no word is below it.
+  //
+  // @TrieNode* list:                   the node list being scored.
+  // @int node:                         the node the prefix ends at.
+  // @int depth:                        the length of the prefix.
+  // @int prefixScore:                  the points of the prefix's letters.
+  // @ScoreTable& table:                the scores.
+  // @vector<int>& bounds:              the best score below each node.
+  int bound(const TrieNode* list, int node, int depth, int prefixScore,
+            const ScoreTable& table, vector<int>& bounds) const;
+
+  // Finds the best words below a node that can be made with the letters
+  // left, skipping every child whose best score can't beat the worst of
+  // the words kept so far.
+  //
+  // Precondition:  The trie has been built and search's bounds were made
+  //                for it.
+  // Postcondition: search keeps the best words found so far.
+  //
+  // @TrieNode* list:                   the node list being searched.
+  // @int node:                         the node the prefix ends at.
+  // @int letterCounts[]:               how many of each letter are left.
+  // @int blanks:                       how many blanks are left.
+  // @int depth:                        the length of the prefix.
+  // @int prefixScore:                  the points of the prefix's letters.
+  // @BestSearch& search:               the scores and the words kept.
+  void searchBest(const TrieNode* list, int node, int letterCounts[], int blanks,
+                  int depth, int prefixScore, BestSearch& search) const;
+
+public:
+  // Default constructor, an empty trie.
+  Trie();
+
+  // Compiles a dictionary into the trie.
+  //
+  // Precondition:  A dictionary exists, it doesn't need to be sorted.
+  // Postcondition: Every word of the dictionary can be found in the trie.
+  //
+  // @vector<string>& dictionary:       a populated list of words.
+  void build(const vector<string>& dictionary);
+
+  // Searches a node list that was compiled ahead of time instead, such as
+  // one mapped from a compiled dictionary file.
+  //
+  // Precondition:  compiledNodes was made by build and outlives the trie.
+  // Postcondition: The trie searches compiledNodes.
+  //
+  // @TrieNode* compiledNodes:          the nodes, breadth first, the root first.
+  // @int count:                        the number of nodes.
+  void attach(const TrieNode* compiledNodes, int count);
+
+  // Returns the nodes of the trie, breadth first, the root first.
+  const TrieNode* data() const;
+
+  // Finds all words in the dictionary that can be made out of letters.
+  // Each blank in letters can stand for any letter.
+  //
+  // Precondition:  The trie has been built.
+  // Postcondition: The positions of the words have been added, once each.
+  //
+  // @string& letters:                  the letters of the user's word.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void findWords(const string& letters, vector<int>& foundWordPositions) const;
+
+  // Splits a search into tasks that can run on different threads.
+  //
+  // Precondition:  The trie has been built.
+  // Postcondition: Words shorter than splitDepth have been found, and running
+  //                every task finds the rest of the words.
+  //
+  // @string& letters:                  the letters of the user's word.
+  // @int splitDepth:                   the length of the tasks' prefixes.
+  // @vector<TrieTask>& tasks:          a list of the tasks made.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void splitSearch(const string& letters, int splitDepth, vector<TrieTask>& tasks,
+                   vector<int>& foundWordPositions) const;
+
+  // Finds the words below the node of a task.
+  //
+  // Precondition:  task was made by splitSearch on this trie.
+  // Postcondition: The positions of the task's words have been added.
+  //
+  // @TrieTask& task:                   the task to run.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void runTask(const TrieTask& task, vector<int>& foundWordPositions) const;
+
+  // Finds the best score of any word below each node, for findBest.
+  //
+  // Precondition:  The trie has been built.
+  // Postcondition: bounds has the best score below each node, or -1.
+  //
+  // @ScoreTable& table:                the scores.
+  // @vector<int>& bounds:              filled with one score per node.
+  void scoreBounds(const ScoreTable& table, vector<int>& bounds) const;
+
+  // Finds the count best scoring words that can be made out of letters.
+  //
+  // Precondition:  bounds was made by scoreBounds with the same table.
+  // Postcondition: best holds up to count words, the best first.
+  //
+  // @string& letters:                  the letters of the user's word.
+  // @ScoreTable& table:                the scores.
+  // @vector<int>& bounds:              the best score below each node.
+  // @int count:                        the number of words wanted.
+  // @int exactLength:                  the length every word must be, 0 for any.
+  // @vector<ScoredWord>& best:         filled with the best words.
+  void findBest(const string& letters, const ScoreTable& table,
+                const vector<int>& bounds, int count, int exactLength,
+                vector<ScoredWord>& best) const;
+
+  // Returns the number of nodes in the trie.
+  int size() const;
+
+  // Returns the bytes the built nodes use, none if they are attached.
+  size_t memoryUsed() const;
+};
+
+#endif
@@ -0,0 +1,543 @@
+/*******************************************************************************
+Title:         word_finder.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Loads a dictionary and finds words with the search the user
+               picked.
+Purpose:       Keeps every search behind one call, so the prompt loop doesn't
+               need to know how each of them works.
+Usage:         ./findwords [--engine legacy|sorted|trie|anagram|histogram|
+                                     louds]
+                           [--exact] [--parallel N] [--cache MB]
+                           [--patterns] [--top K [--scores file]]
+                           [--stats] dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+#include "word_finder.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// ***** Helpers *****
+
+// The length of the prefixes the trie search is split at. Two letters make
+// up to 676 tasks, enough for a thread that finishes early to keep taking
+// work while another is still in a large subtree.
+const int TRIE_SPLIT_DEPTH = 2;
+
+// The state of one search that is split between threads.
+struct ParallelSearch {
+  const string* letters;          // The letters of the user's word.
+  vector<TrieTask> trieTasks;     // The tasks of the trie search.
+  vector<int> firstLetters;       // The tasks of the legacy and sorted
+                                  // searches, one per different first letter.
+  int taskCount;                  // The number of tasks.
+  atomic<int> nextTask;           // The next task to be taken.
+};
+
+// ***** Function Definitions *****
+
+// Default constructor, no dictionary is loaded.
+WordFinder::WordFinder() {
+  engine = LEGACY_ENGINE;
+  exactOnly = false;
+  searchThreads = 1;
+  cache = NULL;
+  statsLog = NULL;
+  patternQueries = false;
+  topCount = 0;
+}
+
+// Loads a text or compiled dictionary, and builds what the search needs.
+bool WordFinder::load(const string& filename, SearchEngine searchEngine) {
+  engine = searchEngine;
+
+  // A compiled dictionary is already a trie, there's no list of words to
+  // search any other way.
+  if (isCompiledDictionary(filename)) {
+    if (engine != TRIE_ENGINE) {
+      cerr << "ERROR! A compiled dictionary can only use the trie engine" << endl;
+      return false;
+    }
+
+    if (!compiled.open(filename))
+      return false;
+
+    compiled.attach(trie);
+    return true;
+  }
+
+  populateDictionary(filename, dictionary);
+  build();
+  return true;
+}
+
+// Uses a list of words that is already in memory as the dictionary.
+void WordFinder::useWords(const vector<string>& words, SearchEngine searchEngine) {
+  engine = searchEngine;
+  compiled.close();
+  dictionary = words;
+  build();
+}
+
+// Builds what the search needs from the dictionary.
+void WordFinder::build() {
+  switch (engine) {
+    // The sorted search needs every prefix in one contiguous range.
+    case SORTED_ENGINE:
+      sortDictionary(dictionary);
+      break;
+    case TRIE_ENGINE:
+      trie.build(dictionary);
+      break;
+    case ANAGRAM_ENGINE:
+      anagrams.build(dictionary);
+      break;
+    case HISTOGRAM_ENGINE:
+      histograms.build(dictionary);
+      break;
+    // The bits hold every word, so the strings aren't needed any more.
+    case LOUDS_ENGINE:
+      louds.build(dictionary);
+      vector<string>().swap(dictionary);
+      break;
+    // Most prefixes the legacy search tries start no word, the filter
+    // saves scanning the dictionary for them.
+    case LEGACY_ENGINE:
+      prefixes.build(dictionary, PREFIX_FILTER_LENGTH);
+      break;
+  }
+
+  if (patternQueries)
+    patterns.build(dictionary);
+  if (topCount > 0 && engine == TRIE_ENGINE)
+    trie.scoreBounds(scores, scoreBounds);
+}
+
+// Makes later searches find only the best scoring words.
+void WordFinder::setTopWords(int count, const ScoreTable& table) {
+  topCount = count;
+  scores = table;
+
+  // The trie skips the parts that can't beat the words it has, so it needs
+  // to know the best score below each node.
+  if (count > 0 && engine == TRIE_ENGINE)
+    trie.scoreBounds(scores, scoreBounds);
+}
+
+// Returns the number of best words searches find, 0 if they find all.
+int WordFinder::topWords() const {
+  return topCount;
+}
+
+// Returns the score of a word found with letters.
+int WordFinder::score(int position, const string& letters) const {
+  return scoreWord(word(position), letters, scores);
+}
+
+// Makes every later query a pattern.
+bool WordFinder::usePatterns() {
+  if (compiled.size() > 0 || engine == LOUDS_ENGINE) {
+    cerr << "ERROR! Patterns need a text dictionary" << endl;
+    return false;
+  }
+
+  patternQueries = true;
+  patterns.build(dictionary);
+  return true;
+}
+
+// Returns true if queries are patterns.
+bool WordFinder::matchesPatterns() const {
+  return patternQueries;
+}
+
+// Returns the filter the legacy search asks before scanning for a prefix.
+const PrefixFilter& WordFinder::prefixFilter() const {
+  return prefixes;
+}
+
+// Sets whether only the words using every letter are found.
+void WordFinder::setExactOnly(bool exact) {
+  exactOnly = exact;
+}
+
+// Sets how many threads share each search.
+void WordFinder::setSearchThreads(int threadCount) {
+  searchThreads = threadCount < 1 ? 1 : threadCount;
+}
+
+// Sets a cache to answer repeated queries from.
+void WordFinder::setCache(ResultCache* resultCache) {
+  cache = resultCache;
+}
+
+// Sets a log to show what the search did for each query.
+void WordFinder::setStatsLog(SearchLog* log) {
+  statsLog = log;
+}
+
+// Finds all words in the dictionary that can be made out of letters.
+bool WordFinder::findWords(const string& letters,
+                           vector<int>& foundWordPositions) const {
+  string key;   // The letters in order, the same for every rearrangement.
+  bool cached = false,
+       valid = true;  // Only a pattern can be malformed.
+  SearchStats stats;
+  chrono::steady_clock::time_point start;
+
+  foundWordPositions.clear();
+
+  // The searches count into this thread's stats while it is set.
+  if (statsLog != NULL) {
+    clearStats(stats);
+    queryStats = &stats;
+    start = chrono::steady_clock::now();
+  }
+
+  // The order of a pattern's letters matters, so it is its own key.
+  if (cache != NULL) {
+    key = patternQueries ? letters : cacheKey(letters);
+    cached = cache->find(key, foundWordPositions);
+  }
+
+  if (!cached) {
+    if (patternQueries) {
+      valid = findPattern(letters, foundWordPositions);
+      sortWords(foundWordPositions);
+    } else if (topCount > 0) {
+      findBestWords(letters, foundWordPositions);
+    } else {
+      findAllWords(letters, foundWordPositions);
+    }
+
+    // A malformed pattern isn't cached, or it would come back as valid.
+    if (cache != NULL && valid)
+      cache->insert(key, foundWordPositions);
+  }
+
+  if (statsLog != NULL) {
+    queryStats = NULL;
+    stats.wordsFound = foundWordPositions.size();
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() -
+                                             start).count();
+    statsLog->record(letters, stats);
+  }
+
+  return valid;
+}
+
+// Finds all words that can be made out of letters with the chosen search.
+void WordFinder::findAllWords(const string& letters,
+                              vector<int>& foundWordPositions) const {
+  bool splittable = engine == LEGACY_ENGINE || engine == SORTED_ENGINE ||
+                    engine == TRIE_ENGINE;
+  // A signature can't have blanks, so those are searched like any other.
+  bool lookUpAnagrams = engine == ANAGRAM_ENGINE && exactOnly &&
+                        countBlanks(letters) == 0;
+
+  if (searchThreads > 1 && splittable)
+    findWordsParallel(letters, foundWordPositions);
+  else switch (engine) {
+    case TRIE_ENGINE:
+      trie.findWords(letters, foundWordPositions);
+      break;
+
+    // A full anagram is one lookup of all of the letters.
+    case ANAGRAM_ENGINE:
+      if (lookUpAnagrams)
+        anagrams.findAnagrams(letters, foundWordPositions);
+      else
+        anagrams.findWords(letters, foundWordPositions);
+      break;
+
+    case HISTOGRAM_ENGINE:
+      histograms.findWords(letters, foundWordPositions);
+      break;
+
+    case LOUDS_ENGINE:
+      louds.findWords(letters, foundWordPositions);
+      break;
+
+    // Search for possible words:
+    // 1. Use 1 letter of the user's word as the prefix
+    // 2. Obtain all letters of the user's word that are not the prefix
+    // 3. Loop through until you've tried every possible letter as a prefix
+    case SORTED_ENGINE:
+    case LEGACY_ENGINE:
+      for (int i = 0; i < letters.length(); i++) {
+        // A repeated letter would only find the same words again.
+        if (letters.find(letters[i]) == i)
+          findWordsStartingAt(letters, i, foundWordPositions);
+      }
+      break;
+  }
+
+  // The other searches have to drop the words that leave letters unused.
+  if (exactOnly && !lookUpAnagrams) {
+    int kept = 0;
+    for (int i = 0; i < foundWordPositions.size(); i++) {
+      if (wordLength(foundWordPositions[i]) == letters.length())
+        foundWordPositions[kept++] = foundWordPositions[i];
+    }
+    foundWordPositions.resize(kept);
+  }
+
+  // Sort the words in our list of found words, and then delete duplicates
+  sortWords(foundWordPositions);
+  deleteDuplicates(foundWordPositions);
+}
+
+// Finds the topCount best scoring words that can be made out of letters.
+void WordFinder::findBestWords(const string& letters,
+                               vector<int>& foundWordPositions) const {
+  vector<ScoredWord> best;
+
+  if (engine == TRIE_ENGINE) {
+    trie.findBest(letters, scores, scoreBounds, topCount,
+                  exactOnly ? letters.length() : 0, best);
+  } else {
+    // The other searches can't tell how good a word will be before they
+    // find it, so find them all and keep the best.
+    vector<int> allWordPositions;
+    findAllWords(letters, allWordPositions);
+
+    for (int i = 0; i < allWordPositions.size(); i++) {
+      ScoredWord word = {allWordPositions[i],
+                         score(allWordPositions[i], letters)};
+      best.push_back(word);
+    }
+
+    int kept = min((int)best.size(), topCount);
+    partial_sort(best.begin(), best.begin() + kept, best.end(), ranksBefore);
+    best.resize(kept);
+  }
+
+  for (int i = 0; i < best.size(); i++)
+    foundWordPositions.push_back(best[i].position);
+}
+
+// Finds the words matching a pattern that a pool of letters can fill.
+bool WordFinder::findPattern(const string& query,
+                             vector<int>& foundWordPositions) const {
+  size_t separator = query.find(POOL_SEPARATOR);
+  string pattern = query.substr(0, separator);
+
+  if (!patterns.findWords(dictionary, pattern, foundWordPositions))
+    return false;
+
+  if (separator != string::npos)
+    keepFillable(dictionary, pattern, query.substr(separator + 1),
+                 foundWordPositions);
+  return true;
+}
+
+// Runs the legacy or sorted search for the words starting with one letter.
+void WordFinder::findWordsStartingAt(const string& letters, int first,
+                                     vector<int>& foundWordPositions) const {
+  LetterPool pool;                 // The letters after the first one.
+  unsigned char letter = letters[first];
+
+  makeLetterPool(letters, pool);
+
+  if (letter != BLANK) {
+    pool.counts[letter]--;
+    findWordsStartingWith(letter, pool, letters.length(), foundWordPositions);
+    return;
+  }
+
+  // A blank first stands for each letter the user doesn't have, the
+  // others are found starting with the real letter.
+  pool.blanks--;
+  for (int blankLetter = 'a'; blankLetter <= 'z'; blankLetter++) {
+    if (pool.counts[blankLetter] == 0)
+      findWordsStartingWith(blankLetter, pool, letters.length(),
+                            foundWordPositions);
+  }
+}
+
+// Runs the legacy or sorted search for the words starting with a letter.
+void WordFinder::findWordsStartingWith(unsigned char letter, LetterPool& pool,
+                                       int length,
+                                       vector<int>& foundWordPositions) const {
+  if (engine == SORTED_ENGINE) {
+    int lo = 0,                  // Range of words starting
+        hi = dictionary.size();  // with the first letter.
+
+    if (letterRange(dictionary, 0, letter, lo, hi))
+      findWordsSorted(dictionary, lo, hi, 1, pool, foundWordPositions);
+  } else {
+    char prefix[length];         // Room for every letter.
+
+    prefix[0] = letter;
+    ::findWords(prefix, 1, pool, dictionary, foundWordPositions, &prefixes);
+  }
+}
+
+// Splits one search into tasks and runs them on searchThreads threads.
+void WordFinder::findWordsParallel(const string& letters,
+                                   vector<int>& foundWordPositions) const {
+  ParallelSearch search;
+  vector<vector<int> > threadWords(searchThreads); // Each thread's own words
+  vector<SearchStats> threadStats(searchThreads);  // and counts, so none of
+  vector<thread> helpers;                          // them lock.
+  SearchStats* callerStats = queryStats;           // The query's counts.
+
+  search.letters = &letters;
+  search.nextTask = 0;
+
+  // The trie is split below its first two letters. The other searches are
+  // split by first letter, and a repeated letter would only find the same
+  // words again.
+  if (engine == TRIE_ENGINE) {
+    trie.splitSearch(letters, TRIE_SPLIT_DEPTH, search.trieTasks,
+                     foundWordPositions);
+    search.taskCount = search.trieTasks.size();
+  } else {
+    for (int i = 0; i < letters.length(); i++) {
+      if (letters.find(letters[i]) == i)
+        search.firstLetters.push_back(i);
+    }
+    search.taskCount = search.firstLetters.size();
+  }
+
+  // This thread takes tasks too.
+  for (int i = 0; i < searchThreads; i++)
+    clearStats(threadStats[i]);
+
+  for (int i = 1; i < searchThreads && i < search.taskCount; i++)
+    helpers.push_back(thread(&WordFinder::runSearchTasks, this, &search,
+                             &threadWords[i],
+                             callerStats == NULL ? NULL : &threadStats[i]));
+
+  runSearchTasks(&search, &threadWords[0],
+                 callerStats == NULL ? NULL : &threadStats[0]);
+
+  for (int i = 0; i < helpers.size(); i++)
+    helpers[i].join();
+
+  if (callerStats != NULL) {
+    for (int i = 0; i < threadStats.size(); i++)
+      addStats(*callerStats, threadStats[i]);
+  }
+
+  for (int i = 0; i < threadWords.size(); i++)
+    foundWordPositions.insert(foundWordPositions.end(),
+                              threadWords[i].begin(), threadWords[i].end());
+}
+
+// Takes tasks of a split search until there are none left.
+void WordFinder::runSearchTasks(ParallelSearch* search,
+                                vector<int>* foundWordPositions,
+                                SearchStats* stats) const {
+  SearchStats* callerStats = queryStats;  // Put back when done, the calling
+  queryStats = stats;                     // thread counts the query too.
+
+  for (int task = search->nextTask++; task < search->taskCount;
+       task = search->nextTask++) {
+    if (engine == TRIE_ENGINE)
+      trie.runTask(search->trieTasks[task], *foundWordPositions);
+    else
+      findWordsStartingAt(*search->letters, search->firstLetters[task],
+                          *foundWordPositions);
+  }
+
+  queryStats = callerStats;
+}
+
+// Returns the word at a position of the dictionary.
+string WordFinder::word(int position) const {
+  if (compiled.size() > 0)
+    return compiled.word(position);
+  if (engine == LOUDS_ENGINE)
+    return louds.word(position);
+  return dictionary[position];
+}
+
+// Returns the length of the word at a position of the dictionary.
+int WordFinder::wordLength(int position) const {
+  if (compiled.size() > 0)
+    return compiled.wordLength(position);
+  if (engine == LOUDS_ENGINE)
+    return louds.wordLength(position);
+  return dictionary[position].length();
+}
+
+// Returns the number of words in the dictionary.
+int WordFinder::size() const {
+  if (compiled.size() > 0)
+    return compiled.size();
+  if (engine == LOUDS_ENGINE)
+    return louds.size();
+  return dictionary.size();
+}
+
+// Returns about how many bytes the words and the search's index use.
+size_t WordFinder::memoryUsed() const {
+  size_t bytes = dictionary.capacity() * sizeof(string);
+
+  // A short word fits inside its string, a longer one has its own block.
+  for (int i = 0; i < dictionary.size(); i++) {
+    if (dictionary[i].capacity() > sizeof(string) / 2)
+      bytes += dictionary[i].capacity() + 1;
+  }
+
+  if (compiled.size() > 0)
+    bytes += compiled.memoryUsed();
+
+  switch (engine) {
+    case TRIE_ENGINE:
+      bytes += trie.memoryUsed();
+      break;
+    case ANAGRAM_ENGINE:
+      bytes += anagrams.memoryUsed();
+      break;
+    case HISTOGRAM_ENGINE:
+      bytes += histograms.memoryUsed();
+      break;
+    case LOUDS_ENGINE:
+      bytes += louds.memoryUsed();
+      break;
+    case LEGACY_ENGINE:
+      bytes += prefixes.memoryUsed();
+      break;
+    case SORTED_ENGINE:
+      break;
+  }
+
+  if (patternQueries)
+    bytes += patterns.memoryUsed();
+  return bytes;
+}
+
+// Returns the longest query the search can answer in reasonable time.
+int WordFinder::maxQueryLength() const {
+  if (engine == LEGACY_ENGINE)
+    return MAX_QUERY_LENGTH;
+  return MAX_RACK_LENGTH;
+}
+
+// Finds the engine with a given name.
+bool engineFromName(const string& name, SearchEngine& engine) {
+  if (name == "legacy")
+    engine = LEGACY_ENGINE;
+  else if (name == "sorted")
+    engine = SORTED_ENGINE;
+  else if (name == "trie")
+    engine = TRIE_ENGINE;
+  else if (name == "anagram")
+    engine = ANAGRAM_ENGINE;
+  else if (name == "histogram")
+    engine = HISTOGRAM_ENGINE;
+  else if (name == "louds")
+    engine = LOUDS_ENGINE;
+  else
+    return false;
+
+  return true;
+}
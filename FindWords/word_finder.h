@@ -0,0 +1,307 @@
+/*******************************************************************************
+Title:         word_finder.h
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Loads a dictionary and finds words with the search the user
+               picked.
+Purpose:       Keeps every search behind one call, so the prompt loop doesn't
+               need to know how each of them works.
+Usage:         ./findwords [--engine legacy|sorted|trie|anagram|histogram|
+                                     louds]
+                           [--exact] [--parallel N] [--cache MB]
+                           [--patterns] [--top K [--scores file]]
+                           [--stats] dictionaryfile.txt
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+
+#ifndef WORD_FINDER_H
+#define WORD_FINDER_H
+
+#include "dictionary.h"
+#include "trie.h"
+#include "compiled_dictionary.h"
+#include "anagram_index.h"
+#include "histogram_filter.h"
+#include "pattern_index.h"
+#include "louds_trie.h"
+#include "prefix_filter.h"
+#include "search_stats.h"
+#include "result_cache.h"
+
+// The state of one search that is split between threads.
+struct ParallelSearch;
+
+// The ways words can be searched for.
+enum SearchEngine {
+  LEGACY_ENGINE,    // findWords and inDictionary.
+  SORTED_ENGINE,    // findWordsSorted on a sorted dictionary.
+  TRIE_ENGINE,      // Trie::findWords.
+  ANAGRAM_ENGINE,   // AnagramIndex::findWords.
+  HISTOGRAM_ENGINE, // HistogramFilter::findWords.
+  LOUDS_ENGINE      // LoudsTrie::findWords, without keeping the words.
+};
+
+class WordFinder {
+private:
+  SearchEngine engine;          // The search being used.
+  bool exactOnly;               // Only find words using every letter.
+  int searchThreads;            // Threads that share one search.
+  ResultCache* cache;           // Remembers recent answers, or NULL.
+  SearchLog* statsLog;          // Where each query's counts go, or NULL.
+  vector<string> dictionary;    // The words, unless a compiled file is used.
+  CompiledDictionary compiled;  // The words and trie of a compiled file.
+  Trie trie;                    // Built for the trie search.
+  AnagramIndex anagrams;        // Built for the anagram search.
+  HistogramFilter histograms;   // Built for the histogram search.
+  LoudsTrie louds;              // Built for the louds search, which then
+                                // frees the dictionary.
+  PrefixFilter prefixes;        // Built for the legacy search.
+  PatternIndex patterns;        // Built when queries are patterns.
+  bool patternQueries;          // Queries are patterns, not letters.
+  int topCount;                 // Only find this many best words, 0 for all.
+  ScoreTable scores;            // How the best words are scored.
+  vector<int> scoreBounds;      // The best score below each trie node.
+
+  // Builds what the search needs from the dictionary.
+  //
+  // Precondition:  dictionary holds the words, engine is set.
+  // Postcondition: Words can be found with the engine.
+  void build();
+
+  // Finds all words that can be made out of letters with the chosen search.
+  //
+  // Precondition:  A dictionary was loaded.
+  // Postcondition: The positions of the words have been added, sorted and
+  //                without duplicates.
+  //
+  // @string& letters:                  the letters of the user's word.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void findAllWords(const string& letters, vector<int>& foundWordPositions) const;
+
+  // Finds the topCount best scoring words. The trie stops following a
+  // prefix once no word below it can beat the words it has, the other
+  // searches find every word and keep the best.
+  //
+  // Precondition:  setTopWords was called.
+  // Postcondition: The positions of the best words have been added, the
+  //                best first.
+  //
+  // @string& letters:                  the letters of the user's word.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void findBestWords(const string& letters, vector<int>& foundWordPositions) const;
+
+  // Finds the words matching a pattern, and if a pool of letters follows
+  // it, only those the pool can fill.
+  //
+  // Precondition:  usePatterns was called.
+  // Postcondition: The positions of the matching words have been added.
+  // return:        false if the pattern has something besides letters, ? and *.
+  //
+  // @string& query:                    a pattern, optionally /letters.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  bool findPattern(const string& query, vector<int>& foundWordPositions) const;
+
+  // Runs the legacy or sorted search for the words starting with one of
+  // the user's letters.
+  //
+  // Precondition:  The engine is LEGACY_ENGINE or SORTED_ENGINE.
+  // Postcondition: The words starting with letters[first] have been found,
+  //                or with any letter the user doesn't have if it is a blank.
+  //
+  // @string& letters:                  the letters of the user's word.
+  // @int first:                        the position of the starting letter.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void findWordsStartingAt(const string& letters, int first,
+                           vector<int>& foundWordPositions) const;
+
+  // Runs the legacy or sorted search for the words starting with a letter
+  // already taken out of the pool.
+  //
+  // Precondition:  The engine is LEGACY_ENGINE or SORTED_ENGINE.
+  // Postcondition: The words starting with letter have been found, and
+  //                pool holds the same letters as before.
+  //
+  // @unsigned char letter:             the starting letter.
+  // @LetterPool& pool:                 the letters after the starting one.
+  // @int length:                       the number of letters, blanks included.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void findWordsStartingWith(unsigned char letter, LetterPool& pool, int length,
+                             vector<int>& foundWordPositions) const;
+
+  // Splits one search into tasks and runs them on searchThreads threads.
+  //
+  // Precondition:  The engine is LEGACY_ENGINE, SORTED_ENGINE or TRIE_ENGINE.
+  // Postcondition: The positions of the words have been added.
+  //
+  // @string& letters:                  the letters of the user's word.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  void findWordsParallel(const string& letters,
+                         vector<int>& foundWordPositions) const;
+
+  // Takes tasks of a split search until there are none left.
+  //
+  // Precondition:  search was set up by findWordsParallel.
+  // Postcondition: The words of the tasks taken have been found, and
+  //                counted in stats.
+  //
+  // @ParallelSearch* search:           the tasks being shared.
+  // @vector<int>* foundWordPositions:  this thread's own list of found positions.
+  // @SearchStats* stats:               this thread's own counts, or NULL.
+  void runSearchTasks(ParallelSearch* search, vector<int>* foundWordPositions,
+                      SearchStats* stats) const;
+
+  // Not copyable, the trie may point into compiled.
+  WordFinder(const WordFinder&);
+  WordFinder& operator=(const WordFinder&);
+
+public:
+  // Default constructor, no dictionary is loaded.
+  WordFinder();
+
+  // Loads a text or compiled dictionary, and builds what the search needs.
+  //
+  // Precondition:  filename is a valid file.
+  // Postcondition: Words can be found with the engine.
+  // return:        false if the dictionary can't be used with the engine.
+  //
+  // @string& filename:                 the name of the dictionary file.
+  // @SearchEngine engine:              the search to use.
+  bool load(const string& filename, SearchEngine engine);
+
+  // Uses a list of words that is already in memory as the dictionary, and
+  // builds what the search needs.
+  //
+  // Precondition:  None.
+  // Postcondition: Words can be found with the engine.
+  //
+  // @vector<string>& words:            a populated list of words.
+  // @SearchEngine engine:              the search to use.
+  void useWords(const vector<string>& words, SearchEngine engine);
+
+  // Sets whether only the words using every letter are found.
+  //
+  // Precondition:  None.
+  // Postcondition: Later searches only find full anagrams if exact is true.
+  //
+  // @bool exact:                       true to only find full anagrams.
+  void setExactOnly(bool exact);
+
+  // Sets how many threads share each search. Only the legacy, sorted and
+  // trie searches can be split.
+  //
+  // Precondition:  None.
+  // Postcondition: Later searches use up to threadCount threads.
+  //
+  // @int threadCount:                  the number of threads, 1 to not split.
+  void setSearchThreads(int threadCount);
+
+  // Sets a cache to answer repeated queries from. The cache must only be
+  // used by one WordFinder, answers of another dictionary or setting differ.
+  //
+  // Precondition:  cache outlives the searches, or is NULL.
+  // Postcondition: Later searches look in the cache first and fill it.
+  //
+  // @ResultCache* resultCache:         the cache to use, NULL for none.
+  void setCache(ResultCache* resultCache);
+
+  // Sets a log to show what the search did for each query.
+  //
+  // Precondition:  log outlives the searches, or is NULL.
+  // Postcondition: Later searches count what they do and record it in log.
+  //
+  // @SearchLog* log:                   the log to use, NULL for none.
+  void setStatsLog(SearchLog* log);
+
+  // Makes later searches find only the best scoring words.
+  //
+  // Precondition:  A dictionary was loaded.
+  // Postcondition: Later searches find up to count words, the best first.
+  //
+  // @int count:                        the number of words wanted, 0 for all.
+  // @ScoreTable& table:                how words are scored.
+  void setTopWords(int count, const ScoreTable& table);
+
+  // Returns the number of best words searches find, 0 if they find all.
+  int topWords() const;
+
+  // Returns the score of a word found with letters.
+  //
+  // Precondition:  0 <= position < size().
+  //
+  // @int position:                     the position of the word.
+  // @string& letters:                  the letters of the user's word.
+  int score(int position, const string& letters) const;
+
+  // Makes every later query a pattern like c?t*, optionally followed by
+  // /letters, instead of letters to make words out of.
+  //
+  // Precondition:  A text dictionary was loaded.
+  // Postcondition: The pattern index has been built.
+  // return:        false if the dictionary is compiled.
+  bool usePatterns();
+
+  // Returns true if queries are patterns.
+  bool matchesPatterns() const;
+
+  // Returns the filter the legacy search asks before scanning for a
+  // prefix, empty for the other searches.
+  const PrefixFilter& prefixFilter() const;
+
+  // Finds all words in the dictionary that can be made out of letters, or
+  // that match a pattern if usePatterns was called.
+  //
+  // Precondition:  A dictionary was loaded, letters is lowercase.
+  // Postcondition: foundWordPositions holds the positions of the words,
+  //                sorted and without duplicates, or the best words first
+  //                if setTopWords was called.
+  // return:        false if a pattern has something besides letters, ? and *
+  //                before its /letters, then no words are found.
+  //
+  // @string& letters:                  the letters of the user's word.
+  // @vector<int>& foundWordPositions:  a list of the positions where words were found.
+  bool findWords(const string& letters, vector<int>& foundWordPositions) const;
+
+  // Returns the word at a position of the dictionary. The louds search has
+  // no list of words, its positions number the words shortest first.
+  //
+  // Precondition:  0 <= position < size().
+  //
+  // @int position:                     the position of the word.
+  string word(int position) const;
+
+  // Returns the length of the word at a position of the dictionary.
+  //
+  // Precondition:  0 <= position < size().
+  //
+  // @int position:                     the position of the word.
+  int wordLength(int position) const;
+
+  // Returns the number of words in the dictionary.
+  int size() const;
+
+  // Returns about how many bytes the words and the search's index use.
+  size_t memoryUsed() const;
+
+  // Returns the longest query the search can answer in reasonable time.
+  // Only the legacy search, which scans the dictionary for every prefix,
+  // is held to MAX_QUERY_LENGTH.
+  int maxQueryLength() const;
+};
+
+
+// Finds the engine with a given name.
+//
+// Precondition:  None.
+// Postcondition: engine is set if the name is known.
+// return:        false if no engine has that name.
+//
+// @string& name:                    legacy, sorted, trie, anagram, histogram
+//                                   or louds.
+// @SearchEngine& engine:            the engine with that name.
+bool engineFromName(const string& name, SearchEngine& engine);
+
+#endif
@@ -0,0 +1,117 @@
+/*******************************************************************************
+Title:         word_score.cpp
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Scores words like Scrabble does, with points for each letter
+               and a bonus for long words.
+Purpose:       Lets the user ask for only the best few words instead of
+               every word that can be made.
+Usage:         ./findwords --top 10 [--scores scores.txt] dictionaryfile.txt
+               A scores file has a letter and its points on each line, like
+               "q 10", or a length and its bonus, like "7 50". The bonus of
+               the longest length listed is also given to longer words.
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+#include "word_score.h"
+
+// ***** Helpers *****
+
+// The points of Scrabble's tiles, a to z.
+const int SCRABBLE_SCORES[26] = {1, 3, 3, 2, 1, 4, 2, 4, 1, 8, 5, 1, 3,
+                                 1, 1, 3, 10, 1, 1, 1, 1, 4, 4, 8, 4, 10};
+
+// The length that earns Scrabble's bonus, and the bonus.
+const int BINGO_LENGTH = 7;
+const int BINGO_BONUS = 50;
+
+// ***** Function Definitions *****
+
+// Fills a table with the points of Scrabble's tiles.
+void defaultScores(ScoreTable& table) {
+  memcpy(table.letterScores, SCRABBLE_SCORES, sizeof(table.letterScores));
+  table.lengthBonus.assign(BINGO_LENGTH + 1, 0);
+  table.lengthBonus[BINGO_LENGTH] = BINGO_BONUS;
+}
+
+// Reads the points of letters and the bonuses of lengths from a file.
+bool loadScores(const string& filename, ScoreTable& table) {
+  ifstream inputStream(filename.c_str());
+  string key;     // A letter or a length.
+  int points;
+
+  if (!inputStream) {
+    cerr << "ERROR! File: " << filename << " cannot be opened" << endl;
+    return false;
+  }
+
+  defaultScores(table);
+
+  while (inputStream >> key) {
+    if (!(inputStream >> points)) {
+      cerr << "ERROR! " << filename << ": no points after " << key << endl;
+      return false;
+    }
+
+    if (key.length() == 1 && key[0] >= 'a' && key[0] <= 'z') {
+      // A blank scores 0, so the best score below a trie node assumes no
+      // letter scores less than that.
+      if (points < 0) {
+        cerr << "ERROR! " << filename << ": " << key
+             << " can't have negative points" << endl;
+        return false;
+      }
+      table.letterScores[key[0] - 'a'] = points;
+    } else if (isdigit(key[0]) && atoi(key.c_str()) > 0) {
+      int length = atoi(key.c_str());
+
+      // Lengths between the old longest and this one keep the old bonus.
+      if (length >= table.lengthBonus.size())
+        table.lengthBonus.resize(length + 1, table.lengthBonus.back());
+      table.lengthBonus[length] = points;
+    } else {
+      cerr << "ERROR! " << filename << ": " << key
+           << " is neither a letter nor a length" << endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Returns the bonus for a word of a given length.
+int lengthBonus(const ScoreTable& table, int length) {
+  if (length >= table.lengthBonus.size())
+    return table.lengthBonus.back();
+  return table.lengthBonus[length];
+}
+
+// Returns the score of a word made out of letters.
+int scoreWord(const string& word, const string& letters, const ScoreTable& table) {
+  LetterPool pool;    // The real letters not used yet.
+  int score = lengthBonus(table, word.length());
+
+  makeLetterPool(letters, pool);
+
+  for (int i = 0; i < word.length(); i++) {
+    unsigned char letter = word[i];
+
+    if (pool.counts[letter] > 0) {
+      pool.counts[letter]--;
+      if (letter >= 'a' && letter <= 'z')
+        score += table.letterScores[letter - 'a'];
+    }
+  }
+
+  return score;
+}
+
+// Checks if one scored word ranks before another.
+bool ranksBefore(const ScoredWord& first, const ScoredWord& second) {
+  if (first.score != second.score)
+    return first.score > second.score;
+  return first.position < second.position;
+}
@@ -0,0 +1,95 @@
+/*******************************************************************************
+Title:         word_score.h
+Author:        David Morant
+Created on:    October 17, 2026
+Description:   Scores words like Scrabble does, with points for each letter
+               and a bonus for long words.
+Purpose:       Lets the user ask for only the best few words instead of
+               every word that can be made.
+Usage:         ./findwords --top 10 [--scores scores.txt] dictionaryfile.txt
+               A scores file has a letter and its points on each line, like
+               "q 10", or a length and its bonus, like "7 50". The bonus of
+               the longest length listed is also given to longer words.
+Build with:    g++ -o findwords find_words.cpp dictionary.cpp trie.cpp
+               compiled_dictionary.cpp anagram_index.cpp word_finder.cpp
+               histogram_filter.cpp pattern_index.cpp word_score.cpp
+               louds_trie.cpp prefix_filter.cpp search_stats.cpp batch.cpp
+               result_cache.cpp server.cpp -pthread
+********************************************************************************/
+
+#ifndef WORD_SCORE_H
+#define WORD_SCORE_H
+
+#include "dictionary.h"
+
+// How words are scored.
+struct ScoreTable {
+  int letterScores[26];     // Points for each letter a to z.
+  vector<int> lengthBonus;  // Extra points for a word of each length, the
+                            // last one for every longer word too.
+};
+
+// A word that was found and its score.
+struct ScoredWord {
+  int position;   // Position of the word in the dictionary.
+  int score;      // Points the word is worth.
+};
+
+// Fills a table with the points of Scrabble's tiles and its 50 point bonus
+// for words of 7 letters or more.
+//
+// Precondition:  None.
+// Postcondition: table holds the Scrabble scores.
+//
+// @ScoreTable& table:                the table to be filled.
+void defaultScores(ScoreTable& table);
+
+
+// Reads the points of letters and the bonuses of lengths from a file, on
+// top of the Scrabble scores.
+//
+// Precondition:  None.
+// Postcondition: table holds the scores of the file.
+// return:        false if the file can't be read or has a line that isn't
+//                a letter or a length followed by a number, or gives a
+//                letter negative points.
+//
+// @string& filename:                 the name of the scores file.
+// @ScoreTable& table:                the table to be filled.
+bool loadScores(const string& filename, ScoreTable& table);
+
+
+// Returns the bonus for a word of a given length.
+//
+// Precondition:  None.
+// Postcondition: None.
+//
+// @ScoreTable& table:                the scores.
+// @int length:                       the length of the word.
+int lengthBonus(const ScoreTable& table, int length);
+
+
+// Returns the score of a word made out of letters. A letter that had to
+// come from a blank is worth nothing, real letters are used first from left
+// to right, the same way the searches use them.
+//
+// Precondition:  word can be made out of letters.
+// Postcondition: None.
+//
+// @string& word:                     a word that was found.
+// @string& letters:                  the letters of the user's word.
+// @ScoreTable& table:                the scores.
+int scoreWord(const string& word, const string& letters, const ScoreTable& table);
+
+
+// Checks if one scored word ranks before another: a higher score first,
+// and the earlier word in the dictionary first for the same score.
+//
+// Precondition:  None.
+// Postcondition: None.
+//
+// @ScoredWord& first:                a word.
+// @ScoredWord& second:               another word.
+bool ranksBefore(const ScoredWord& first, const ScoredWord& second);
+
+#endif
@@ -10,7 +10,8 @@ Purpose :     Practice using stacks and exception handling in order to make
 Usage :       ./calc 2>errorfile
                     OR
               ./calc sometextfile.txt 2>errorfile
-Build with :  g++ -o calc main.cpp calculator.cpp utility.cpp
+Build with :  g++ -std=c++17 -o calc main.cpp calculator.cpp utility.cpp
+              program.cpp table.cpp parallel.cpp -pthread
 Modifications: November 16, 2014
                Transcribed algorithm from textbook.
                November 17 - 18, 2014
@@ -18,9 +19,52 @@ Modifications: November 16, 2014
                November 20, 2014
                Fixed balanced bracket algorithm.
                Commenting
+               October 17, 2026
+               Compile expressions to a postfix program instead of
+               evaluating them while parsing.
+               Names in expressions are variables instead of errors.
+               Read expressions in one pass over a string_view, without
+               copying operands or allocating for each expression.
 ******************************************************************************/
 #include "utility.h"
 #include "calculator.h"
+#include "program.h"
+
+#include <charconv>
+
+// ***** Helpers *****
+
+// What the last thing read in an expression was. Brackets don't count.
+enum Unit {
+    NO_UNIT,        // Nothing yet.
+    OPERAND_UNIT,   // A number or a variable.
+    OPERATOR_UNIT   // An operator.
+};
+
+// Returns how many characters at i are part of a number: one for anything
+// that isn't an operator, a bracket or the start of a name. An exponent,
+// e or E then an optional sign then a digit, is part of the number too, so
+// 1e3 and 2E-1 are numbers rather than a number and a name.
+static size_t numberPart(string_view text, size_t i) {
+    char token = text[i];
+
+    if (token == 'e' || token == 'E') {
+        size_t sign = i + 1 < text.length() &&
+                      (text[i+1] == '+' || text[i+1] == '-') ? 1 : 0;
+
+        if (i + 1 + sign < text.length() &&
+            isdigit((unsigned char)text[i+1+sign])) {
+            return 1 + sign;
+        }
+    }
+
+    return isNonDigit(token) == 0 && isLetter(token) == 0 ? 1 : 0;
+}
+
+// Returns how many characters at i are part of a name.
+static size_t namePart(string_view text, size_t i) {
+    return isLetter(text[i]) || isdigit((unsigned char)text[i]) ? 1 : 0;
+}
 
 // Default Constructor, intentionally empty.
 Calculator::Calculator() {}
@@ -47,52 +91,97 @@ int Calculator::precedence(char token) {
 	return 0;
 }
 
-// Sets the expression given by the user.
-void Calculator::setExpression(string theirExpression) {
-    expression = theirExpression;
+// Sets the expression given by the user. The expression's space is reused
+// from one expression to the next.
+void Calculator::setExpression(string_view theirExpression) {
+    expression.assign(theirExpression.data(), theirExpression.length());
 }
 
-// Takes out unnecessary spaces from the input for convenience.
-void Calculator::formatExpression(string& expr) {
-    for (int i = 0; i < expr.length(); i++) {
-        if (expr[i] == ' ') {
-            expr.erase(i, 1);
-            i--;
+// Calculates an entire infix expression.
+void Calculator::calculate() {  // throw(int)
+    compile(program);
+
+    // There are no values for variables here.
+    if (!program.variables().empty()) {
+        throw(0);
+    }
+
+    result = program.evaluate();
+}
+
+// Reads an operand, the characters at i that partLength counts. Spaces
+// are skipped as if they had been taken out first, so "1 2" is 12. Only
+// then are the operand's characters copied, to spacedOperand.
+string_view Calculator::readOperand(string_view text, size_t& i,
+                                    size_t (*partLength)(string_view, size_t)) {
+    size_t start = i,
+           end = i;         // Just past the last character of the operand.
+    bool spaced = false;    // A space came between two of its characters.
+
+    while (i < text.length()) {
+        if (text[i] == ' ') {
+            i++;
+            continue;
         }
+
+        size_t length = partLength(text, i);
+        if (length == 0) {
+            break;
+        }
+        spaced = spaced || end != i;
+        i += length;
+        end = i;
+    }
+
+    if (!spaced) {
+        return text.substr(start, end - start);
     }
+
+    spacedOperand.clear();
+    for (size_t j = start; j < end; j++) {
+        if (text[j] != ' ') {
+            spacedOperand += text[j];
+        }
+    }
+    return spacedOperand;
 }
 
-// Calculates an entire infix expression.
-void Calculator::calculate() throw(int){
-    char ch;                    // Character to be checked in an expression.
-    int i = 0,                  // Simple counter.
-        brackets = 0;           // Keeps track of the number of brackets.
-    string unit = "";           // Holds a string to recognize what TYPE the previous item was.
-    string singleOperand = "";  // A single operand in an expression.
-    stack<double> valStack;     // Stack holding values to be used for expressions.
-    stack<char> opStack;        // Stack holding operators to be used for expressions.
+// Compiles an entire infix expression to postfix order, reading it once.
+void Calculator::compile(Program& program) {  // throw(int)
+    string_view text = expression;  // The expression being read.
+    size_t i = 0;                   // Where the next character is.
+    int brackets = 0;               // Keeps track of the number of brackets.
+    Unit unit = NO_UNIT;            // What TYPE the previous item was.
 
+    program.clear();
+    opStack.clear();
 
-    // Used for convenience; takes out spaces from the expression.
-    formatExpression(expression);
+    // Spaces don't matter, only the characters around them.
+    size_t first = text.find_first_not_of(' '),
+           last = text.find_last_not_of(' ');
 
-    // If the expression starts or ends with an operator, it's malformatted.
-    if (isOperator(expression.back()) || isOperator(expression.front())) {
+    // Nothing to calculate.
+    if (first == string_view::npos) {
         throw(0);
     }
 
-    while (i < expression.length()){
-        ch = expression[i];
+    // If the expression starts or ends with an operator, it's malformatted.
+    if (isOperator(text[first]) || isOperator(text[last])) {
+        throw(0);
+    }
 
-        // We're not doing algebra, so there won't be any letters.
-        if (isalpha(ch)) {
-            throw(0);
-        }
+    while (i < text.length()) {
+        char ch = text[i];
 
         switch (ch) {
+            case ' ':
+                i++;
+                break;
+
             case '(':
-                opStack.push(ch);
+                opStack.push_back(ch);
                 brackets++;
+                i++;
                 break;
 
             // Finish all executions within a set of parenthesis
@@ -104,61 +193,74 @@ void Calculator::calculate() throw(int){
                 }
 
                 // Evaluate all expressions within a set of parenthesis.
-                while (opStack.top() != '(') {
-                    execute(valStack, opStack);
+                while (opStack.back() != '(') {
+                    emit(program, opStack);
                 }
 
-                opStack.pop();
+                opStack.pop_back();
+                i++;
                 break;
 
             // In the case of any operator:
             case '+': case '-': case '/': case '*': case '^':
-                if (unit == "operator") {
+                if (unit == OPERATOR_UNIT) {
                 // The unit before this was also an operator.
                     throw(0);
                 } else {
-                    unit = "operator";
+                    unit = OPERATOR_UNIT;
                 }
 
-                if (opStack.empty())
-                    opStack.push(ch);
-                else if (precedence(ch) > precedence(opStack.top()))
-                    opStack.push(ch);
-                else {
-                    // When you have a lower precedence, the item with higher precedence
-                    // needs to happen first, then add this operation to the stack.
-                    while (!opStack.empty() && precedence(ch) <= precedence(opStack.top()))
-                        execute(valStack, opStack);
-                    opStack.push(ch);
+                // When you have a lower precedence, the item with higher precedence
+                // needs to happen first, then add this operation to the stack.
+                while (!opStack.empty() && precedence(ch) <= precedence(opStack.back())) {
+                    emit(program, opStack);
                 }
+                opStack.push_back(ch);
+                i++;
                 break;
 
             // It's not a special type of character
-            // Add all non operator characters to the value stack
+            // Add all non operator characters to the program
             default:
-                while (isNonDigit(expression[i]) == 0 && i < expression.length()) {
-                    singleOperand = singleOperand + expression[i];
-                    i++;
-                }
-                // If the string has multiple decimals, it's not a real double.
-                if (decimals(singleOperand) > 1) {
-                    throw(1);
-                }
+                // A name, which starts with a letter, is a variable. A
+                // number ends where a name starts, so 2x is two operands,
+                // unless the letter starts an exponent like in 1e3.
+                if (isLetter(ch)) {
+                    string_view name = readOperand(text, i, namePart);
 
-                // The value before this was an operand.
-                if (unit == "operand") {
-                    throw(0);
+                    if (unit == OPERAND_UNIT) {
+                        throw(0);
+                    }
+                    unit = OPERAND_UNIT;
+
+                    program.pushVariable(name);
                 } else {
-                    unit = "operand";
-                }
+                    string_view number = readOperand(text, i, numberPart);
+                    double value = 0;
+
+                    if (count(number.begin(), number.end(), '.') > 1) {
+                        throw(1);
+                    }
 
-                // Have to get back to the position before the operator.
-                valStack.push(atof(singleOperand.c_str()));
-                singleOperand = "";
-                i--;
+                    // The value before this was an operand.
+                    if (unit == OPERAND_UNIT) {
+                        throw(0);
+                    }
+                    unit = OPERAND_UNIT;
+
+                    // Like atof, the number is as much of the operand as
+                    // reads as one after any tabs, and 0 if none of it does.
+                    while (!number.empty() && isspace((unsigned char)number[0])) {
+                        number.remove_prefix(1);
+                    }
+                    if (from_chars(number.data(), number.data() + number.length(),
+                                   value).ec != errc()) {
+                        value = 0;
+                    }
+                    program.pushValue(value);
+                }
                 break;
         }
-        i++;
     }
 
     // If there are remaining brackets that means the brackets are not balanced.
@@ -166,12 +268,15 @@ void Calculator::calculate() throw(int){
         throw(0);
     }
 
-    // Do the final calculations of what's left in the stacks
-    while (!opStack.empty() && !valStack.empty()) {
-        execute(valStack, opStack);
+    // Add the operations left on the stack
+    while (!opStack.empty()) {
+        emit(program, opStack);
     }
 
-    result = valStack.top();
+    // Operators and operands don't match up, like in (+3).
+    if (!program.complete()) {
+        throw(0);
+    }
 }
 
 // Returns the value of result.
@@ -180,35 +285,11 @@ double Calculator::getResult() {
 }
 
 // Algorithm given:
-// Performs remaining operations on remaining operands.
-void Calculator::execute(stack<double>& valStack, stack<char>& opStack) throw(int){
-    // Take what's on top of the stacks and then pop them.
-    char operatorToken;
-    operand2 = valStack.top();
-    valStack.pop();
-    operand1 = valStack.top();
-    valStack.pop();
-    operatorToken = opStack.top();
-    opStack.pop();
-
-    // Compute the values of each partial expression.
-    switch (operatorToken) {
-        case '+':
-            result = operand1 + operand2;
-            break;
-        case '-':
-            result = operand1 - operand2;
-            break;
-        case '*':
-            result = operand1 * operand2;
-            break;
-        case '/':
-            result = operand1 / operand2;
-            break;
-        case '^':
-            result = pow(operand1, operand2);
-            break;
-    }
+// Adds the operator on top of the stack to the program, where it will be
+// applied to the two values before it.
+void Calculator::emit(Program& program, vector<char>& opStack) {  // throw(int)
+    char operatorToken = opStack.back();
+    opStack.pop_back();
 
-    valStack.push(result);
-}
\ No newline at end of file
+    program.pushOperator(operatorToken);
+}
@@ -10,7 +10,8 @@ Purpose :     Practice using stacks and exception handling in order to make
 Usage :       ./calc 2>errorfile
                     OR
               ./calc sometextfile.txt 2>errorfile
-Build with :   g++ -o calc main.cpp calculator.cpp utility.cpp
+Build with :   g++ -std=c++17 -o calc main.cpp calculator.cpp utility.cpp
+               program.cpp table.cpp parallel.cpp -pthread
 Modifications: November 16, 2014
                Transcribed algorithm from textbook.
                November 19, 2014
@@ -19,19 +20,42 @@ Modifications: November 16, 2014
                November 20, 2014
                Added functions better suited here than utility
                Commenting
+               October 17, 2026
+               Added compile, so an expression can be parsed once and its
+               program evaluated many times.
+               Names in expressions are variables, given values when the
+               program is evaluated.
+               Read expressions in one pass, with the operator stack and the
+               expression's space kept from one expression to the next.
 ******************************************************************************/
 #ifndef CALCULATOR_H
 #define CALCULATOR_H
 
 #include "utility.h"
+#include "program.h"
 
 class Calculator {
 private:
-    double result,
-           operand1,
-           operand2;
+    double result;
 
     string expression;
+    Program program;        // The last expression calculated, compiled.
+    vector<char> opStack;   // The operators waiting while compiling.
+    string spacedOperand;   // An operand with spaces in it, without them.
+
+    // Reads an operand, skipping spaces inside it.
+    //
+    // Precondition:  partLength(text, i) isn't 0.
+    // Postcondition: i is just past the operand and the spaces after it.
+    // return:        The operand's characters, a view of text unless they
+    //                had to be copied to spacedOperand.
+    //
+    // @string_view text:   The expression being read.
+    // @size_t& i:          Where the operand starts.
+    // @size_t partLength(string_view, size_t): How many characters at a
+    //                      position belong to the operand, 0 if none do.
+    string_view readOperand(string_view text, size_t& i,
+                            size_t (*partLength)(string_view, size_t));
 
 public:
     // Default constructor.
@@ -45,40 +69,41 @@ public:
     // @char token: the operator that needs its precedence found.
     int precedence(char token);
 
-    // Calculates the partial infix expression.
+    // Calculates the infix expression.
+    //
+    // Precondition:  An expression without variables has already been set.
+    // Postcondition: The result of the expression is found.
+    void calculate(); // throw(int)
+
+    // Compiles the infix expression to a program that calculates it, so it
+    // can be evaluated again without parsing it again.
     //
     // Precondition:  An expression has already been set.
-    // Postcondition: The calculation of the two operands is done. 
-    void calculate() throw(int);
+    // Postcondition: program calculates the expression.
+    //
+    // @Program& program: The program to be filled.
+    void compile(Program& program); // throw(int)
 
 
     // Returns the result of the calculations.
     double getResult();
 
-    // Evaluates partial expressions of the stacks.
-    //
-    // Precondition:  valStack and opStack are not empty. 
-    // Postcondition: An expression is evaluated. 
-    //
-    // @stack<double>& valStack: Stack containing the values of operands in an expression.
-    // @stack<char>& opStack:    Stack containing the operators in an expression.
-    void execute(stack<double>& valStack, stack<char>& opStack) throw(int);
-
-    // Formats an expression by removing whitespace.
+    // Adds the operator on top of the stack to a program.
     //
-    // Precondition:  The expression given by the user.
-    // Postcondition: Whitespace has been removed from expression.
+    // Precondition:  opStack is not empty.
+    // Postcondition: The operator is applied by the program.
     //
-    // @string& expression: The expression given by the user.
-    void formatExpression(string& expression); // throw(int)
+    // @Program& program:     The program being compiled.
+    // @vector<char>& opStack: Stack containing the operators in an expression.
+    void emit(Program& program, vector<char>& opStack); // throw(int)
 
     // Sets the expression given by the user
     //
     // Precondition:  The user supplies an expression.
     // Postcondition: The expression has been set
     //
-    // @string expression: The expression the user wants to set.
-    void setExpression(string expression);
+    // @string_view expression: The expression the user wants to set.
+    void setExpression(string_view expression);
 };
 
 #endif
\ No newline at end of file
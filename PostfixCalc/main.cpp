@@ -9,8 +9,11 @@ Purpose :     Practice using stacks and exception handling in order to make
               efficient/standardized way.
 Usage :       ./calc 2>errorfile
                     OR
-              ./calc sometextfile.txt 2>errorfile
-Build with :  g++ -o calc main.cpp calculator.cpp utility.cpp
+              ./calc [--threads N] sometextfile.txt 2>errorfile
+                    OR
+              ./calc --table bindings.csv "expression" 2>errorfile
+Build with :  g++ -std=c++17 -o calc main.cpp calculator.cpp utility.cpp
+              program.cpp table.cpp parallel.cpp -pthread
 Modifications: November 16, 2014
                Transcribed algorithm from textbook.
                November 19, 2014
@@ -18,23 +21,144 @@ Modifications: November 16, 2014
                November 20, 2014
                Fixed command line input parsing. 
                Commenting
+               October 17, 2026
+               Added --table, which calculates an expression with variables
+               for every row of a CSV file.
+               Calculate each line as it is read instead of reading all of
+               them first, so memory stays the same however long the input.
+               Calculate files on a thread for each core, or --threads N.
 ******************************************************************************/
 #include "utility.h"
 #include "calculator.h"
+#include "table.h"
+#include "parallel.h"
+
+#include <thread>
+
+// Calculates an expression for every row of a CSV file, each of its
+// variables taking the value of the column with its name, and shows one
+// result a line.
+//
+// Precondition:  None.
+// Postcondition: The results, or why there are none, have been shown.
+// return:        0 if every row was calculated, otherwise 1.
+//
+// @char* filename:    The name of the CSV file.
+// @string expression: The expression to calculate.
+int calculateTable(char* filename, string expression) {
+    ifstream inputFile;
+    Calculator calculator;
+    Program program;
+    Table table;
+    vector<const double*> columns;  // The column of each variable.
+    size_t badLine;
+
+    inputFile.open(filename);
+    switch (fileStatus(inputFile)) {
+        case 1:
+            cout << "The file you provided cannot be opened." << endl;
+            return 1;
+        case 2:
+            cout << "The file you provided could not be found." << endl;
+            return 1;
+    }
+
+    badLine = table.readCSV(inputFile);
+    inputFile.close();
+    if (badLine != 0) {
+        cout << "Line " << badLine << " of the file you provided is not a row of numbers." << endl;
+        return 1;
+    }
+
+    try {
+        calculator.setExpression(expression);
+        calculator.compile(program);
+    } catch (int x) {
+        cerr << expression << endl;
+        return 1;
+    }
+
+    for (int i = 0; i < program.variables().size(); i++) {
+        columns.push_back(NULL);
+        if (!table.column(program.variables()[i], columns.back())) {
+            cout << "The file you provided has no column " << program.variables()[i] << "." << endl;
+            return 1;
+        }
+    }
+
+    // Many rows are calculated at once, and shown without flushing each line.
+    vector<double> results(table.rows());
+    program.evaluateColumns(columns, table.rows(), results.data());
+
+    for (size_t row = 0; row < results.size(); row++) {
+        cout << results[row] << '\n';
+    }
+    cout.flush();
+
+    return 0;
+}
+
+// Calculates each line of a stream as soon as it is read, and shows its
+// result, or shows the line as an error.
+//
+// Precondition:  input is open.
+// Postcondition: Every line of input has been calculated.
+//
+// @istream& input:         The expressions, one per line.
+// @Calculator& calculator: The calculator that calculates them.
+void calculateStream(istream& input, Calculator& calculator) {
+    string expressionLine;          // One instance of a line from the input.
+
+    while (getline(input, expressionLine)) {
+        try {
+            calculator.setExpression(expressionLine);
+            calculator.calculate();
+            cout << calculator.getResult() << " = " << expressionLine << '\n';
+
+            // The line was not formatted correctly
+            } catch (int x) {
+                cerr << expressionLine << endl;
+            }
+
+        // Show the results so far when the next line isn't here yet, so a
+        // pipe or a person typing sees each result as soon as it's ready,
+        // while a file's results are written a buffer at a time.
+        if (input.rdbuf()->in_avail() <= 0) {
+            cout.flush();
+        }
+    }
+
+    cout.flush();
+}
 
 int main(int argc, char *argv[]) {
     ifstream inputFile;             // Stream of the file provided.
     int temp;                       // Temporary int to record the status of the file.
-    string userInput;               // One instance of userInput from the command line.
-    string expressionLine;          // One instance of a line from the file.
+    int threadCount;                // Threads calculating a file.
     Calculator calculator;          // A calculator.
-    vector<string> expressions;     // A vector of expressions regardless of where the input comes from.
+
+    // Without this cin doesn't buffer, and can't tell when a line is waiting.
+    // Reading cin doesn't flush cout either, calculateStream decides when to.
+    ios::sync_with_stdio(false);
+    cin.tie(NULL);
 
     // The "Magic Formula", used to set the number of positions after the decimal to 3.
     cout.setf(ios::fixed);
     cout.setf(ios::showpoint);
     cout.precision(3);
 
+    // An expression for every row of a table.
+    if (argc == 4 && string(argv[1]) == "--table") {
+        return calculateTable(argv[2], argv[3]);
+    }
+
+    // A file is calculated on every core unless told otherwise.
+    threadCount = thread::hardware_concurrency();
+    if (argc >= 3 && string(argv[1]) == "--threads") {
+        threadCount = atoi(argv[2]);
+        argv += 2;
+    }
+
 	// Discern the file if one is provided on the command line, and find out its status.
     if (argv[1]) {
         inputFile.open(argv[1]);
@@ -43,10 +167,11 @@ int main(int argc, char *argv[]) {
         switch(temp){
             // 0: The file is accessible.
             case 0:
-                while (getline(inputFile, expressionLine)) {
-                    expressions.push_back(expressionLine);
+                if (threadCount > 1) {
+                    calculateParallel(inputFile, threadCount);
+                } else {
+                    calculateStream(inputFile, calculator);
                 }
-
                 inputFile.close();
                 break;
 
@@ -66,23 +191,7 @@ int main(int argc, char *argv[]) {
         }
     } else {
         cout << "Enter expressions (1 per line). When done, press Ctrl-D" << endl;
-        while (!cin.eof() &&  getline(cin, userInput)) {
-            expressions.push_back(userInput);
-        }
-    }
-
-    // Regardless of how we obtained the inputs, try each output to see if it works.
-    for (int i = 0; i < expressions.size(); i++) {
-        try {
-            calculator.setExpression(expressions[i]);
-            calculator.calculate();
-            cout << calculator.getResult() << " = " << expressions[i] << endl;
-
-            // The file was not formatted correctly
-            } catch (int x) {
-                cerr << expressions[i] << endl;
-                continue;
-            }
+        calculateStream(cin, calculator);
     }
 
 	return 0;
@@ -0,0 +1,172 @@
+/******************************************************************************
+Title :       parallel.cpp
+Author :      David Morant
+Created on :  October 17, 2026
+Description : Calculates the lines of a file on a pool of threads, a block of
+              lines at a time, and shows the results in the file's order.
+Purpose :     Every line is calculated on its own, so a long file can use
+              every core instead of one.
+Usage :       ./calc --threads 8 sometextfile.txt 2>errorfile
+Build with :  g++ -std=c++17 -o calc main.cpp calculator.cpp utility.cpp
+              program.cpp table.cpp parallel.cpp -pthread
+******************************************************************************/
+#include "parallel.h"
+#include "calculator.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+// ***** Helpers *****
+
+// Some lines of the file and what calculating them shows.
+struct Block {
+    vector<string> lines;   // The lines, reused from block to block.
+    int lineCount;          // How many of lines belong to this block.
+    string results,         // What goes to cout, in order.
+           errors;          // What goes to cerr, in order.
+    bool done;              // The lines have been calculated.
+};
+
+// What the threads share. The main thread reads blocks and shows them, the
+// workers calculate them.
+struct BlockQueue {
+    deque<Block*> waiting;      // Blocks read but not taken by a worker.
+    bool finished;              // No more blocks are coming.
+    mutex lock;                 // Protects everything here and each done.
+    condition_variable blockReady,  // Signals a block is waiting, or the end.
+                       blockDone;   // Signals a block was calculated.
+};
+
+// Calculates the lines of a block the way calculateStream shows them.
+static void calculateBlock(Block* block, Calculator& calculator,
+                           ostringstream& results, ostringstream& errors) {
+    results.str("");
+    errors.str("");
+
+    for (int i = 0; i < block->lineCount; i++) {
+        try {
+            calculator.setExpression(block->lines[i]);
+            calculator.calculate();
+            results << calculator.getResult() << " = " << block->lines[i] << '\n';
+
+            // The line was not formatted correctly
+            } catch (int x) {
+                errors << block->lines[i] << '\n';
+            }
+    }
+
+    block->results = results.str();
+    block->errors = errors.str();
+}
+
+// Calculates blocks until there are none left, with its own calculator.
+static void blockWorker(BlockQueue* queue) {
+    Calculator calculator;
+    ostringstream results,
+                  errors;
+
+    // The same "Magic Formula" as cout.
+    results.setf(ios::fixed);
+    results.setf(ios::showpoint);
+    results.precision(3);
+
+    while (true) {
+        Block* block;
+
+        {
+            unique_lock<mutex> guard(queue->lock);
+            while (!queue->finished && queue->waiting.empty())
+                queue->blockReady.wait(guard);
+
+            if (queue->waiting.empty())
+                return;
+
+            block = queue->waiting.front();
+            queue->waiting.pop_front();
+        }
+
+        calculateBlock(block, calculator, results, errors);
+
+        unique_lock<mutex> guard(queue->lock);
+        block->done = true;
+        queue->blockDone.notify_all();
+    }
+}
+
+// ***** Function Definitions *****
+
+// Calculates every line of a stream on a pool of threads, and shows the
+// results in order. Only a few blocks are read ahead, so memory stays the
+// same however long the input is.
+void calculateParallel(istream& input, int threadCount) {
+    vector<Block> blocks(threadCount * BLOCKS_PER_THREAD);
+    vector<Block*> freeBlocks;      // Blocks that can be read into.
+    deque<Block*> reading;          // Blocks being calculated, in file order.
+    vector<thread> workers;         // The pool of threads.
+    BlockQueue queue;
+
+    queue.finished = false;
+    for (int i = 0; i < blocks.size(); i++) {
+        blocks[i].lines.resize(BLOCK_LINES);
+        freeBlocks.push_back(&blocks[i]);
+    }
+
+    for (int i = 0; i < threadCount; i++)
+        workers.push_back(thread(blockWorker, &queue));
+
+    while (true) {
+        // Every block is in use, show the oldest once it's calculated.
+        if (freeBlocks.empty()) {
+            Block* oldest = reading.front();
+
+            {
+                unique_lock<mutex> guard(queue.lock);
+                while (!oldest->done)
+                    queue.blockDone.wait(guard);
+            }
+
+            cout << oldest->results;
+            cerr << oldest->errors;
+            reading.pop_front();
+            freeBlocks.push_back(oldest);
+        }
+
+        Block* block = freeBlocks.back();
+        block->lineCount = 0;
+        block->done = false;
+
+        while (block->lineCount < BLOCK_LINES &&
+               getline(input, block->lines[block->lineCount]))
+            block->lineCount++;
+
+        if (block->lineCount == 0)
+            break;
+
+        freeBlocks.pop_back();
+        reading.push_back(block);
+
+        unique_lock<mutex> guard(queue.lock);
+        queue.waiting.push_back(block);
+        queue.blockReady.notify_one();
+    }
+
+    {
+        unique_lock<mutex> guard(queue.lock);
+        queue.finished = true;
+        queue.blockReady.notify_all();
+    }
+
+    for (int i = 0; i < workers.size(); i++)
+        workers[i].join();
+
+    // The workers are done with every block, show what's left in order.
+    for (int i = 0; i < reading.size(); i++) {
+        cout << reading[i]->results;
+        cerr << reading[i]->errors;
+    }
+
+    cout.flush();
+}
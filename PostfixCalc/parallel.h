@@ -0,0 +1,36 @@
+/******************************************************************************
+Title :       parallel.h
+Author :      David Morant
+Created on :  October 17, 2026
+Description : Calculates the lines of a file on a pool of threads, a block of
+              lines at a time, and shows the results in the file's order.
+Purpose :     Every line is calculated on its own, so a long file can use
+              every core instead of one.
+Usage :       ./calc --threads 8 sometextfile.txt 2>errorfile
+Build with :  g++ -std=c++17 -o calc main.cpp calculator.cpp utility.cpp
+              program.cpp table.cpp parallel.cpp -pthread
+******************************************************************************/
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "utility.h"
+
+// Lines given to a thread at once.
+const int BLOCK_LINES = 4096;
+
+// Blocks read ahead for each thread, so reading, calculating and showing
+// results overlap without the whole file being read.
+const int BLOCKS_PER_THREAD = 2;
+
+// Calculates every line of a stream on a pool of threads, each with its own
+// calculator, and shows the results and errors exactly as calculating them
+// one at a time would, a block at a time.
+//
+// Precondition:  input is open.
+// Postcondition: Every line of input has been calculated.
+//
+// @istream& input:  The expressions, one per line.
+// @int threadCount: The number of threads calculating.
+void calculateParallel(istream& input, int threadCount);
+
+#endif
@@ -0,0 +1,273 @@
+/******************************************************************************
+Title :       program.cpp
+Author :      David Morant
+Created on :  October 17, 2026
+Description : An infix expression compiled to postfix order, a flat list of
+              instructions that push values, load variables and apply
+              operators.
+Purpose :     Parse a formula once and evaluate it as many times as needed,
+              without tokenizing or sorting operators again, one set of
+              variables at a time or a whole table of them in batches.
+Usage :       Calculator calculator;
+              Program program;
+              calculator.setExpression("2 * (x + 4)");
+              calculator.compile(program);
+              double x = 3;
+              double value = program.evaluate(&x);
+Build with :  g++ -std=c++17 -o calc main.cpp calculator.cpp utility.cpp
+              program.cpp table.cpp parallel.cpp -pthread
+******************************************************************************/
+#include "program.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// ***** Helpers *****
+
+// Applies an operator to a batch of rows: first[i] op second[i] for each.
+// result may be first. pow has no vector form, so POWER is done a row at a
+// time.
+static void applyBatch(Opcode opcode, const double* first, const double* second,
+                       double* result, int rows) {
+    int i = 0;
+
+#if defined(__AVX2__)
+    for (; opcode != POWER && i + 4 <= rows; i += 4) {
+        __m256d a = _mm256_loadu_pd(first + i),
+                b = _mm256_loadu_pd(second + i);
+
+        switch (opcode) {
+            case ADD:      a = _mm256_add_pd(a, b); break;
+            case SUBTRACT: a = _mm256_sub_pd(a, b); break;
+            case MULTIPLY: a = _mm256_mul_pd(a, b); break;
+            case DIVIDE:   a = _mm256_div_pd(a, b); break;
+            default:       break;
+        }
+        _mm256_storeu_pd(result + i, a);
+    }
+#elif defined(__SSE2__)
+    for (; opcode != POWER && i + 2 <= rows; i += 2) {
+        __m128d a = _mm_loadu_pd(first + i),
+                b = _mm_loadu_pd(second + i);
+
+        switch (opcode) {
+            case ADD:      a = _mm_add_pd(a, b); break;
+            case SUBTRACT: a = _mm_sub_pd(a, b); break;
+            case MULTIPLY: a = _mm_mul_pd(a, b); break;
+            case DIVIDE:   a = _mm_div_pd(a, b); break;
+            default:       break;
+        }
+        _mm_storeu_pd(result + i, a);
+    }
+#endif
+
+    // The rows left over, or every row of POWER.
+    for (; i < rows; i++) {
+        switch (opcode) {
+            case ADD:      result[i] = first[i] + second[i]; break;
+            case SUBTRACT: result[i] = first[i] - second[i]; break;
+            case MULTIPLY: result[i] = first[i] * second[i]; break;
+            case DIVIDE:   result[i] = first[i] / second[i]; break;
+            case POWER:    result[i] = pow(first[i], second[i]); break;
+            default:       break;
+        }
+    }
+}
+
+// ***** Function Definitions *****
+
+// Default constructor, an empty program.
+Program::Program() {
+    depth = 0;
+    maxDepth = 0;
+}
+
+// Removes every instruction.
+void Program::clear() {
+    instructions.clear();
+    variableNames.clear();
+    depth = 0;
+    maxDepth = 0;
+}
+
+// Adds an instruction that pushes a value.
+void Program::pushValue(double value) {
+    Instruction instruction;
+
+    instruction.opcode = PUSH;
+    instruction.variable = 0;
+    instruction.value = value;
+    instructions.push_back(instruction);
+
+    depth++;
+    if (depth > maxDepth) {
+        maxDepth = depth;
+    }
+}
+
+// Adds an instruction that pushes the value of a variable. A variable used
+// twice is loaded from the same value.
+void Program::pushVariable(string_view name) {
+    Instruction instruction;
+    int variable = 0;
+
+    while (variable < variableNames.size() && variableNames[variable] != name) {
+        variable++;
+    }
+
+    if (variable == variableNames.size()) {
+        variableNames.push_back(string(name));
+    }
+
+    instruction.opcode = LOAD;
+    instruction.variable = variable;
+    instruction.value = 0;
+    instructions.push_back(instruction);
+
+    depth++;
+    if (depth > maxDepth) {
+        maxDepth = depth;
+    }
+}
+
+// Adds an instruction that applies an operator to the top two values.
+void Program::pushOperator(char token) {  // throw(int)
+    Instruction instruction;
+
+    // An operator without two operands, like the + in (+3).
+    if (depth < 2) {
+        throw(0);
+    }
+
+    switch (token) {
+        case '+':
+            instruction.opcode = ADD;
+            break;
+        case '-':
+            instruction.opcode = SUBTRACT;
+            break;
+        case '*':
+            instruction.opcode = MULTIPLY;
+            break;
+        case '/':
+            instruction.opcode = DIVIDE;
+            break;
+        case '^':
+            instruction.opcode = POWER;
+            break;
+        default:
+            throw(0);
+    }
+
+    instruction.variable = 0;
+    instruction.value = 0;
+    instructions.push_back(instruction);
+    depth--;
+}
+
+// Checks if the program leaves exactly one value, its result.
+bool Program::complete() const {
+    return depth == 1;
+}
+
+// Returns the number of instructions.
+int Program::size() const {
+    return instructions.size();
+}
+
+// Returns the names of the variables, in the order evaluate takes their values.
+const vector<string>& Program::variables() const {
+    return variableNames;
+}
+
+// Runs every instruction in order. The stack never grows past maxDepth, so
+// it is checked once here instead of at every push.
+double Program::evaluate(const double* variableValues) const {
+    double localValues[MAX_STACK_DEPTH];    // The stack of most programs.
+    vector<double> deepValues;              // The stack of deeper ones.
+    double* values = localValues;
+    int top = -1;                           // Where the top value is.
+
+    if (maxDepth > MAX_STACK_DEPTH) {
+        deepValues.resize(maxDepth);
+        values = &deepValues[0];
+    }
+
+    const Instruction* instruction = instructions.data();
+    const Instruction* end = instruction + instructions.size();
+
+    for (; instruction != end; instruction++) {
+        switch (instruction->opcode) {
+            case PUSH:
+                values[++top] = instruction->value;
+                break;
+            case LOAD:
+                values[++top] = variableValues[instruction->variable];
+                break;
+            case ADD:
+                values[top - 1] = values[top - 1] + values[top];
+                top--;
+                break;
+            case SUBTRACT:
+                values[top - 1] = values[top - 1] - values[top];
+                top--;
+                break;
+            case MULTIPLY:
+                values[top - 1] = values[top - 1] * values[top];
+                top--;
+                break;
+            case DIVIDE:
+                values[top - 1] = values[top - 1] / values[top];
+                top--;
+                break;
+            case POWER:
+                values[top - 1] = pow(values[top - 1], values[top]);
+                top--;
+                break;
+        }
+    }
+
+    return values[top];
+}
+
+// Runs the program for every row of a table, BATCH_SIZE rows at a time.
+// Each value on the stack is a batch of rows. A loaded variable is read
+// straight from its column instead of being copied onto the stack.
+void Program::evaluateColumns(const vector<const double*>& columns,
+                              size_t rows, double* results) const {
+    vector<double> batches(maxDepth * BATCH_SIZE);  // The stack's rows.
+    vector<const double*> values(maxDepth);         // Where each value's rows are.
+
+    for (size_t row = 0; row < rows; row += BATCH_SIZE) {
+        int count = min((size_t)BATCH_SIZE, rows - row),
+            top = -1;
+
+        for (int i = 0; i < instructions.size(); i++) {
+            const Instruction& instruction = instructions[i];
+            double* batch;
+
+            switch (instruction.opcode) {
+                case PUSH:
+                    batch = &batches[++top * BATCH_SIZE];
+                    fill(batch, batch + count, instruction.value);
+                    values[top] = batch;
+                    break;
+                case LOAD:
+                    values[++top] = columns[instruction.variable] + row;
+                    break;
+                default:
+                    top--;
+                    batch = &batches[top * BATCH_SIZE];
+                    applyBatch(instruction.opcode, values[top], values[top + 1],
+                               batch, count);
+                    values[top] = batch;
+                    break;
+            }
+        }
+
+        copy(values[0], values[0] + count, results + row);
+    }
+}
@@ -0,0 +1,127 @@
+/******************************************************************************
+Title :       program.h
+Author :      David Morant
+Created on :  October 17, 2026
+Description : An infix expression compiled to postfix order, a flat list of
+              instructions that push values, load variables and apply
+              operators.
+Purpose :     Parse a formula once and evaluate it as many times as needed,
+              without tokenizing or sorting operators again, one set of
+              variables at a time or a whole table of them in batches.
+Usage :       Calculator calculator;
+              Program program;
+              calculator.setExpression("2 * (x + 4)");
+              calculator.compile(program);
+              double x = 3;
+              double value = program.evaluate(&x);
+Build with :  g++ -std=c++17 -o calc main.cpp calculator.cpp utility.cpp
+              program.cpp table.cpp parallel.cpp -pthread
+******************************************************************************/
+#ifndef PROGRAM_H
+#define PROGRAM_H
+
+#include "utility.h"
+
+// Values evaluate keeps on its own stack. Deeper programs use the heap.
+const int MAX_STACK_DEPTH = 64;
+
+// Rows evaluateColumns carries through the program at once. Each value on
+// its stack is this many values, so each instruction is one loop the
+// processor can do several rows of at a time.
+const int BATCH_SIZE = 256;
+
+// What one instruction does.
+enum Opcode {
+    PUSH,       // Pushes its value.
+    LOAD,       // Pushes the value of its variable.
+    ADD,        // Replaces the top two values with their sum.
+    SUBTRACT,   // ... with the lower minus the top.
+    MULTIPLY,   // ... with their product.
+    DIVIDE,     // ... with the lower divided by the top.
+    POWER       // ... with the lower to the power of the top.
+};
+
+// One step of a program.
+struct Instruction {
+    Opcode opcode;  // What the step does.
+    int variable;   // The variable loaded, only used by LOAD.
+    double value;   // The value pushed, only used by PUSH.
+};
+
+class Program {
+private:
+    vector<Instruction> instructions;
+    vector<string> variableNames;   // The variables, in the order of their values.
+    int depth,          // Values on the stack after the last instruction.
+        maxDepth;       // The most values on the stack at once.
+
+public:
+    // Default constructor, an empty program.
+    Program();
+
+    // Removes every instruction.
+    //
+    // Precondition:  None.
+    // Postcondition: The program is empty.
+    void clear();
+
+    // Adds an instruction that pushes a value.
+    //
+    // Precondition:  None.
+    // Postcondition: The value is pushed after the other instructions.
+    //
+    // @double value: The value to push.
+    void pushValue(double value);
+
+    // Adds an instruction that pushes the value of a variable.
+    //
+    // Precondition:  None.
+    // Postcondition: The variable's value is pushed after the other
+    //                instructions, and the variable is in variables().
+    //
+    // @string_view name: The name of the variable.
+    void pushVariable(string_view name);
+
+    // Adds an instruction that applies an operator to the top two values.
+    //
+    // Precondition:  token is an operator.
+    // Postcondition: The operator is applied after the other instructions.
+    //
+    // @char token: The operator to apply.
+    void pushOperator(char token); // throw(int)
+
+    // Checks if the program leaves exactly one value, its result.
+    bool complete() const;
+
+    // Returns the number of instructions.
+    int size() const;
+
+    // Returns the names of the variables, in the order evaluate takes their
+    // values.
+    const vector<string>& variables() const;
+
+    // Runs every instruction in order.
+    //
+    // Precondition:  complete() is true, and values holds a value for each
+    //                of variables().
+    // Postcondition: None.
+    // return:        The value the program leaves.
+    //
+    // @double* values: The value of each variable, NULL if there are none.
+    double evaluate(const double* values = NULL) const;
+
+    // Runs the program for every row of a table, BATCH_SIZE rows at a time.
+    //
+    // Precondition:  complete() is true, columns holds a column of rows
+    //                values for each of variables(), and results has room
+    //                for rows values.
+    // Postcondition: results holds the value of each row.
+    //
+    // @vector<const double*>& columns: The values of each variable, a row each.
+    // @size_t rows:                    The number of rows.
+    // @double* results:                Where each row's value goes.
+    void evaluateColumns(const vector<const double*>& columns, size_t rows,
+                         double* results) const;
+};
+
+#endif
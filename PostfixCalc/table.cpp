@@ -0,0 +1,117 @@
+/******************************************************************************
+Title :       table.cpp
+Author :      David Morant
+Created on :  October 17, 2026
+Description : A table of numbers read from a CSV file, kept a column at a
+              time, with the first line naming the columns.
+Purpose :     Give the variables of an expression their values for every
+              row, in the layout evaluateColumns reads in batches.
+Usage :       ./calc --table bindings.csv "price * (1 + tax)" 2>errorfile
+Build with :  g++ -std=c++17 -o calc main.cpp calculator.cpp utility.cpp
+              program.cpp table.cpp parallel.cpp -pthread
+******************************************************************************/
+#include "table.h"
+
+// ***** Helpers *****
+
+// Takes the spaces and the carriage return of a Windows file off the ends.
+static string trim(const string& text) {
+    size_t first = text.find_first_not_of(" \t\r"),
+           last = text.find_last_not_of(" \t\r");
+
+    if (first == string::npos) {
+        return "";
+    }
+    return text.substr(first, last - first + 1);
+}
+
+// ***** Function Definitions *****
+
+// Default constructor, an empty table.
+Table::Table() {
+    rowCount = 0;
+}
+
+// Reads a table from CSV, one column at a time.
+size_t Table::readCSV(istream& input) {
+    string line;
+    size_t lineNumber = 1;
+
+    names.clear();
+    columns.clear();
+    rowCount = 0;
+
+    // The first line names the columns.
+    if (!getline(input, line)) {
+        return lineNumber;
+    }
+
+    size_t start = 0;
+    while (start <= line.length()) {
+        size_t comma = line.find(',', start);
+        if (comma == string::npos) {
+            comma = line.length();
+        }
+
+        names.push_back(trim(line.substr(start, comma - start)));
+        if (names.back().empty()) {
+            return lineNumber;
+        }
+        start = comma + 1;
+    }
+    columns.resize(names.size());
+
+    // Every other line is a row of numbers, one for each column.
+    while (getline(input, line)) {
+        const char* next = line.c_str();
+        lineNumber++;
+
+        // Blank lines, like the one at the end of a file, aren't rows.
+        if (trim(line).empty()) {
+            continue;
+        }
+
+        for (int i = 0; i < columns.size(); i++) {
+            char* end;
+            double value = strtod(next, &end);
+
+            // No number where one should be.
+            if (end == next) {
+                return lineNumber;
+            }
+
+            while (*end == ' ' || *end == '\t' || *end == '\r') {
+                end++;
+            }
+
+            // A number is followed by a comma, the last one by the end.
+            if (*end != (i + 1 < columns.size() ? ',' : '\0')) {
+                return lineNumber;
+            }
+
+            columns[i].push_back(value);
+            next = end + 1;
+        }
+
+        rowCount++;
+    }
+
+    return 0;
+}
+
+// Finds the values of a column, false if there is no such column.
+bool Table::column(const string& name, const double*& values) const {
+    for (int i = 0; i < names.size(); i++) {
+        if (names[i] == name) {
+            values = columns[i].data();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Returns the number of rows.
+size_t Table::rows() const {
+    return rowCount;
+}
@@ -0,0 +1,54 @@
+/******************************************************************************
+Title :       table.h
+Author :      David Morant
+Created on :  October 17, 2026
+Description : A table of numbers read from a CSV file, kept a column at a
+              time, with the first line naming the columns.
+Purpose :     Give the variables of an expression their values for every
+              row, in the layout evaluateColumns reads in batches.
+Usage :       ./calc --table bindings.csv "price * (1 + tax)" 2>errorfile
+Build with :  g++ -std=c++17 -o calc main.cpp calculator.cpp utility.cpp
+              program.cpp table.cpp parallel.cpp -pthread
+******************************************************************************/
+#ifndef TABLE_H
+#define TABLE_H
+
+#include "utility.h"
+
+class Table {
+private:
+    vector<string> names;               // The name of each column.
+    vector<vector<double> > columns;    // Each column's values, a row each.
+    size_t rowCount;
+
+public:
+    // Default constructor, an empty table.
+    Table();
+
+    // Reads a table from CSV: a line of column names, then a line of
+    // numbers for each row. Spaces around names and numbers are ignored.
+    //
+    // Precondition:  input is open.
+    // Postcondition: The table holds every row read.
+    // return:        0 if every line was read, otherwise the number of the
+    //                first line that couldn't be.
+    //
+    // @istream& input: The CSV to read.
+    size_t readCSV(istream& input);
+
+    // Finds the values of a column. A table with no rows has columns
+    // whose values may be NULL.
+    //
+    // Precondition:  None.
+    // Postcondition: values points at the column's rows if it was found.
+    // return:        true if there is such a column, otherwise false.
+    //
+    // @string name:            The name of the column.
+    // @const double*& values:  Where the column's values are put.
+    bool column(const string& name, const double*& values) const;
+
+    // Returns the number of rows.
+    size_t rows() const;
+};
+
+#endif
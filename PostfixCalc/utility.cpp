@@ -10,10 +10,14 @@ Purpose :     Practice using stacks and exception handling in order to make
 Usage :       ./calc 2>errorfile
                     OR
               ./calc sometextfile.txt 2>errorfile
-Build with :  g++ -o calc main.cpp calculator.cpp utility.cpp
+Build with :  g++ -std=c++17 -o calc main.cpp calculator.cpp utility.cpp
+              program.cpp table.cpp parallel.cpp -pthread
 Modifications: November 20, 2014
                Separated isOperator from isNonDigit for convenience in
                calculator implementation. 
+               October 17, 2026
+               Added isLetter for variable names.
+               Removed decimals, operands are checked as they are read.
 ******************************************************************************/
 #include "utility.h"
 #include "calculator.h"
@@ -55,16 +59,11 @@ int isOperator(char token) {
     }
 }
 
-// Checks to see if there are multiple decimals in an operand
-int decimals(string operand) {
-    int decimalNum = 0;
-    for (int i = 0; i < operand.length(); i++) {
-        if (operand[i] == '.') {
-            decimalNum++;
-      }
+// Checks if a token can start a variable name.
+int isLetter(char token) {
+    if (isalpha((unsigned char)token) || token == '_') {
+      return 1;
+    } else {
+      return 0;
     }
-
-    // If the number of decimals is more than one, e.g. 1.23.45.6
-    // the number isn't truly a double. 
-    return decimalNum;
-}
\ No newline at end of file
+}
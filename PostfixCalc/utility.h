@@ -10,11 +10,16 @@ Purpose :     Practice using stacks and exception handling in order to make
 Usage :       ./calc 2>errorfile
                     OR
               ./calc sometextfile.txt 2>errorfile
-Build with :  g++ -o calc main.cpp calculator.cpp utility.cpp
+Build with :  g++ -std=c++17 -o calc main.cpp calculator.cpp utility.cpp
+              program.cpp table.cpp parallel.cpp -pthread
 Modifications: November 20, 2014
                Separated isOperator from isNonDigit for convenience in
                calculator implementation.
                Removed functions better suited for calculator object. 
+               October 17, 2026
+               Added isLetter for variable names.
+               Included string_view and algorithm, now built as C++17.
+               Removed decimals, operands are checked as they are read.
 ******************************************************************************/
 #ifndef UTILITY_H
 #define UTILITY_H
@@ -22,6 +27,8 @@ Modifications: November 20, 2014
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <string_view>
+#include <algorithm>
 #include <stack>
 #include <cmath>
 #include <stdlib.h>
@@ -52,13 +59,13 @@ int isNonDigit(char token);
 // @char token: The token to be checked.
 int isOperator(char token);
 
-// Checks how many decimals are in an operator.
+// Checks if a token can start a variable name: a letter or an underscore.
 //
-// Precondition:  An operand has been supplied and created. 
+// Precondition:  None.
 // Postcondition: None.
 //
-// @string operand: The operand to be checked for decimals.
-int decimals(string operand);
+// @char token: The token to be checked.
+int isLetter(char token);
 
 
 #endif
\ No newline at end of file